@@ -33,3 +33,11 @@ $CXX $CXXFLAGS $EXTRA_FLAGS -I$OPENBLAS_INCLUDE -L$OPENBLAS_LIB $SOURCE_FILE -o
 # - The profiling data file is `gmon.out`
 # - Redirect the output to a file named `profile_report.txt`
 gprof $OUTPUT_FILE gmon.out > profile_report.txt
+
+# === Mixed-precision and integer GEMM comparison ===
+#
+# Single-threaded SGEMM against DGEMM, and float-compute/double-accumulate,
+# int16 and int8 dot-product kernels against a double kernel of the same loop
+# structure; the integer kernels pick VNNI/AVX2 at run time
+$CXX $CXXFLAGS $EXTRA_FLAGS -I$OPENBLAS_INCLUDE -L$OPENBLAS_LIB matmul_precision.cpp -o matmul_precision -lopenblas
+./matmul_precision > precision.txt
@@ -0,0 +1,438 @@
+#include <cstdlib>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <immintrin.h>
+#include "cblas.h"
+
+using namespace std;
+
+//
+// Mixed-precision and integer GEMM variants, each validated against the double
+// precision DGEMM reference:
+//   SGEMM  single precision OpenBLAS
+//   F64    double dot-product kernel (AVX2 FMA), baseline for the kernels below
+//   FxD    float products accumulated in double
+//   I16    int16 x int16 -> int32 (AVX2 madd)
+//   I8     uint8 x int8 -> int32 (AVX-512 VNNI / AVX-VNNI dpbusd, AVX2 maddubs fallback)
+// The integer inputs are quantized from the same real matrices; their scales
+// are chosen so that an n-term int32 accumulation cannot overflow.
+//
+// Speedups compare like with like. OpenBLAS runs on one thread and SGEMM is
+// measured against DGEMM. F64, FxD, I16 and I8 share one loop structure (one
+// dot product per C entry over a transposed, padded B, single-threaded, no
+// blocking) and are measured against F64.
+//
+
+struct Result {
+    double wall_seconds;
+    double max_rel_error;   // max |C - C_ref| / max |C_ref|
+};
+
+// Operands for the dot-product kernels (quantized for the integer ones): A
+// row-major, B transposed, both zero-padded along k to a multiple of 64 so the
+// vector loops have no tail
+template <typename TA, typename TB>
+struct Quantized {
+    int n1, n2, n3, kpad;
+    double scale_a, scale_b;       // real value = q / scale
+    vector<TA> a;                  // n1 x kpad
+    vector<TB> bt;                 // n3 x kpad
+};
+
+void init_matrix(vector<double>& a, int rows, int cols, unsigned seed);
+void reference_dgemm(const vector<double>& a, const vector<double>& b, vector<double>& c, int n1, int n2, int n3);
+Result f64_matmul(const vector<double>& a, const vector<double>& b, const vector<double>& ref, int n1, int n2, int n3);
+Result sgemm_matmul(const vector<double>& a, const vector<double>& b, const vector<double>& ref, int n1, int n2, int n3);
+Result mixed_matmul(const vector<double>& a, const vector<double>& b, const vector<double>& ref, int n1, int n2, int n3);
+Result int16_matmul(const vector<double>& a, const vector<double>& b, const vector<double>& ref, int n1, int n2, int n3);
+Result int8_matmul(const vector<double>& a, const vector<double>& b, const vector<double>& ref, int n1, int n2, int n3);
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000;
+    int n1 = n, n2 = n, n3 = n;
+    double ops = 2.0 * (double)n1 * (double)n2 * (double)n3;
+
+    std::cout << "\n";
+    std::cout << "  Matrix A(" << n1 << ", " << n2 << ")" << std::endl;
+    std::cout << "  Matrix B(" << n2 << ", " << n3 << ")" << std::endl;
+    std::cout << "  Number of operations = " << ops << std::endl;
+    std::cout << "  Int8 kernel: "
+              << (__builtin_cpu_supports("avx512vnni") ? "AVX-512 VNNI"
+                  : __builtin_cpu_supports("avxvnni") ? "AVX-VNNI"
+                  : __builtin_cpu_supports("avx2") ? "AVX2 maddubs" : "scalar")
+              << ", Int16 kernel: " << (__builtin_cpu_supports("avx2") ? "AVX2 madd" : "scalar") << std::endl;
+
+    vector<double> A((size_t)n1 * n2), B((size_t)n2 * n3), C((size_t)n1 * n3);
+    init_matrix(A, n1, n2, 1325);
+    init_matrix(B, n2, n3, 1326);
+
+    // The custom kernels are single-threaded; keep OpenBLAS to one thread as well
+    openblas_set_num_threads(1);
+
+    auto start = std::chrono::steady_clock::now();
+    reference_dgemm(A, B, C, n1, n2, n3);
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> dgemm_seconds = end - start;
+
+    std::cout << std::endl;
+    std::cout << "  Method   Walltime [s]   GOP/s           Speedup         Max rel error" << std::endl;
+    std::cout << "  ------  --------------  --------------  --------------  --------------" << std::endl;
+
+    auto print_row = [&](const char* name, Result r, double baseline_seconds) {
+        std::cout << "  " << setw(6) << left << name << right << fixed << setprecision(4)
+                  << "  " << setw(14) << r.wall_seconds
+                  << "  " << setw(14) << setprecision(2) << ops / r.wall_seconds / 1e9
+                  << "  " << setw(13) << baseline_seconds / r.wall_seconds << "x"
+                  << "  " << setw(14) << scientific << setprecision(3) << r.max_rel_error
+                  << defaultfloat << std::endl;
+    };
+
+    std::cout << "  OpenBLAS, one thread (speedup over DGEMM)" << std::endl;
+    print_row("DGEMM", Result{dgemm_seconds.count(), 0.0}, dgemm_seconds.count());
+    print_row("SGEMM", sgemm_matmul(A, B, C, n1, n2, n3), dgemm_seconds.count());
+
+    std::cout << "  Dot-product kernels, one thread (speedup over F64)" << std::endl;
+    Result f64 = f64_matmul(A, B, C, n1, n2, n3);
+    print_row("F64", f64, f64.wall_seconds);
+    print_row("FxD", mixed_matmul(A, B, C, n1, n2, n3), f64.wall_seconds);
+    print_row("I16", int16_matmul(A, B, C, n1, n2, n3), f64.wall_seconds);
+    print_row("I8", int8_matmul(A, B, C, n1, n2, n3), f64.wall_seconds);
+
+    return 0;
+}
+
+// initialize matrix with a fixed seed, values in [0, 1)
+void init_matrix(vector<double>& a, int rows, int cols, unsigned seed)
+{
+    srand(seed);
+    for (size_t i = 0; i < (size_t)rows * cols; i++)
+        a[i] = (double)(rand() % 1000) / 1000.0;
+}
+
+double max_rel_error(const vector<double>& c, const vector<double>& ref)
+{
+    double max_diff = 0.0, max_ref = 0.0;
+    for (size_t i = 0; i < ref.size(); i++) {
+        max_diff = std::max(max_diff, std::fabs(c[i] - ref[i]));
+        max_ref = std::max(max_ref, std::fabs(ref[i]));
+    }
+    return max_diff / max_ref;
+}
+
+void reference_dgemm(const vector<double>& a, const vector<double>& b, vector<double>& c, int n1, int n2, int n3)
+{
+    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, n1, n3, n2, 1.0, a.data(), n2, b.data(), n3, 0.0, c.data(), n3);
+}
+
+//
+// SGEMM: float inputs, float accumulation (OpenBLAS)
+Result sgemm_matmul(const vector<double>& a, const vector<double>& b, const vector<double>& ref, int n1, int n2, int n3)
+{
+    vector<float> af(a.begin(), a.end()), bf(b.begin(), b.end()), cf((size_t)n1 * n3);
+
+    auto start = std::chrono::steady_clock::now();
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, n1, n3, n2, 1.0f, af.data(), n2, bf.data(), n3, 0.0f, cf.data(), n3);
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> wall_seconds = end - start;
+
+    vector<double> c(cf.begin(), cf.end());
+    return {wall_seconds.count(), max_rel_error(c, ref)};
+}
+
+// Copy A (n1 x n2) and B (n2 x n3, stored transposed) into the same padded
+// layout the quantized kernels use, converting to T
+template <typename T>
+Quantized<T, T> pack(const vector<double>& a, const vector<double>& b, int n1, int n2, int n3)
+{
+    Quantized<T, T> p;
+    p.n1 = n1; p.n2 = n2; p.n3 = n3;
+    p.kpad = (n2 + 63) / 64 * 64;
+    p.scale_a = p.scale_b = 1.0;
+    p.a.assign((size_t)n1 * p.kpad, 0);
+    p.bt.assign((size_t)n3 * p.kpad, 0);
+    for (int i = 0; i < n1; i++)
+        for (int k = 0; k < n2; k++)
+            p.a[(size_t)i * p.kpad + k] = (T)a[(size_t)i * n2 + k];
+    for (int k = 0; k < n2; k++)
+        for (int j = 0; j < n3; j++)
+            p.bt[(size_t)j * p.kpad + k] = (T)b[(size_t)k * n3 + j];
+    return p;
+}
+
+// The loop shared by every dot-product kernel: one dot product per entry of C,
+// row i of A against row j of the transposed B. Returns the wall time.
+template <typename TA, typename TB, typename TC, typename Dot>
+double dot_gemm(Dot dot, const Quantized<TA, TB>& q, vector<TC>& c)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < q.n1; i++)
+        for (int j = 0; j < q.n3; j++)
+            c[(size_t)i * q.n3 + j] = dot(&q.a[(size_t)i * q.kpad], &q.bt[(size_t)j * q.kpad], q.kpad);
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> wall_seconds = end - start;
+    return wall_seconds.count();
+}
+
+static inline double hsum_pd(__m256d v) __attribute__((target("avx2")));
+static inline double hsum_pd(__m256d v)
+{
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+// --- double and float x float -> double kernels ---
+
+double dot_f64_scalar(const double* a, const double* b, int kpad)
+{
+    double sum = 0.0;
+    for (int k = 0; k < kpad; k++)
+        sum += a[k] * b[k];
+    return sum;
+}
+
+// Four independent FMA chains of four doubles each
+__attribute__((target("avx2,fma")))
+double dot_f64_avx2(const double* a, const double* b, int kpad)
+{
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+    for (int k = 0; k < kpad; k += 16) {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + k + 4), _mm256_loadu_pd(b + k + 4), acc1);
+        acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + k + 8), _mm256_loadu_pd(b + k + 8), acc2);
+        acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + k + 12), _mm256_loadu_pd(b + k + 12), acc3);
+    }
+    return hsum_pd(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+}
+
+double dot_fxd_scalar(const float* a, const float* b, int kpad)
+{
+    double sum = 0.0;
+    for (int k = 0; k < kpad; k++)
+        sum += (double)(a[k] * b[k]);
+    return sum;
+}
+
+// Eight float products per multiply, widened to double in two halves
+__attribute__((target("avx2")))
+double dot_fxd_avx2(const float* a, const float* b, int kpad)
+{
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+    for (int k = 0; k < kpad; k += 16) {
+        __m256 p0 = _mm256_mul_ps(_mm256_loadu_ps(a + k), _mm256_loadu_ps(b + k));
+        __m256 p1 = _mm256_mul_ps(_mm256_loadu_ps(a + k + 8), _mm256_loadu_ps(b + k + 8));
+        acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(p0)));
+        acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(p0, 1)));
+        acc2 = _mm256_add_pd(acc2, _mm256_cvtps_pd(_mm256_castps256_ps128(p1)));
+        acc3 = _mm256_add_pd(acc3, _mm256_cvtps_pd(_mm256_extractf128_ps(p1, 1)));
+    }
+    return hsum_pd(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+}
+
+//
+// F64: double operands and accumulation in the dot-product loop structure
+Result f64_matmul(const vector<double>& a, const vector<double>& b, const vector<double>& ref, int n1, int n2, int n3)
+{
+    auto p = pack<double>(a, b, n1, n2, n3);
+    const bool fma = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    vector<double> c((size_t)n1 * n3);
+    double wall_seconds = dot_gemm(fma ? dot_f64_avx2 : dot_f64_scalar, p, c);
+    return {wall_seconds, max_rel_error(c, ref)};
+}
+
+//
+// FxD: products formed in float, accumulated in double
+Result mixed_matmul(const vector<double>& a, const vector<double>& b, const vector<double>& ref, int n1, int n2, int n3)
+{
+    auto p = pack<float>(a, b, n1, n2, n3);
+    vector<double> c((size_t)n1 * n3);
+    double wall_seconds = dot_gemm(__builtin_cpu_supports("avx2") ? dot_fxd_avx2 : dot_fxd_scalar, p, c);
+    return {wall_seconds, max_rel_error(c, ref)};
+}
+
+// Quantize A (n1 x n2) and B (n2 x n3, stored transposed) to integers in
+// [-qmax_a, qmax_a] and [-qmax_b, qmax_b]
+template <typename TA, typename TB>
+Quantized<TA, TB> quantize(const vector<double>& a, const vector<double>& b, int n1, int n2, int n3, int qmax_a, int qmax_b)
+{
+    Quantized<TA, TB> q;
+    q.n1 = n1; q.n2 = n2; q.n3 = n3;
+    q.kpad = (n2 + 63) / 64 * 64;
+    double amax = 0.0, bmax = 0.0;
+    for (double v : a) amax = std::max(amax, std::fabs(v));
+    for (double v : b) bmax = std::max(bmax, std::fabs(v));
+    q.scale_a = amax > 0.0 ? qmax_a / amax : 1.0;
+    q.scale_b = bmax > 0.0 ? qmax_b / bmax : 1.0;
+
+    q.a.assign((size_t)n1 * q.kpad, 0);
+    q.bt.assign((size_t)n3 * q.kpad, 0);
+    for (int i = 0; i < n1; i++)
+        for (int k = 0; k < n2; k++)
+            q.a[(size_t)i * q.kpad + k] = (TA)std::lround(a[(size_t)i * n2 + k] * q.scale_a);
+    for (int k = 0; k < n2; k++)
+        for (int j = 0; j < n3; j++)
+            q.bt[(size_t)j * q.kpad + k] = (TB)std::lround(b[(size_t)k * n3 + j] * q.scale_b);
+    return q;
+}
+
+// Largest |q| such that n products of two such values summed in int32 cannot overflow
+int int32_safe_qmax(int n, int type_max)
+{
+    double limit = std::sqrt((double)INT32_MAX / std::max(n, 1));
+    return std::min(type_max, (int)limit);
+}
+
+// Dequantize, then check a sample of entries bit-exactly against a 64-bit scalar dot product
+template <typename TA, typename TB>
+double validate(const Quantized<TA, TB>& q, const vector<int32_t>& ci, const vector<double>& ref, bool& exact)
+{
+    exact = true;
+    for (int s = 0; s < 1000; s++) {
+        int i = (int)(((uint64_t)s * 2654435761u) % q.n1);
+        int j = (int)(((uint64_t)s * 40503u + 7) % q.n3);
+        int64_t dot = 0;
+        for (int k = 0; k < q.n2; k++)
+            dot += (int64_t)q.a[(size_t)i * q.kpad + k] * q.bt[(size_t)j * q.kpad + k];
+        if (dot != ci[(size_t)i * q.n3 + j])
+            exact = false;
+    }
+    vector<double> c(ci.size());
+    const double inv = 1.0 / (q.scale_a * q.scale_b);
+    for (size_t i = 0; i < ci.size(); i++)
+        c[i] = ci[i] * inv;
+    return max_rel_error(c, ref);
+}
+
+// --- int16 x int16 -> int32 kernels ---
+
+int32_t dot_i16_scalar(const int16_t* a, const int16_t* b, int kpad)
+{
+    int32_t sum = 0;
+    for (int k = 0; k < kpad; k++)
+        sum += (int32_t)a[k] * b[k];
+    return sum;
+}
+
+static inline int32_t hsum_epi32(__m256i v) __attribute__((target("avx2")));
+static inline int32_t hsum_epi32(__m256i v)
+{
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(s);
+}
+
+// madd multiplies 16 int16 pairs and sums adjacent products into 8 int32 lanes
+__attribute__((target("avx2")))
+int32_t dot_i16_avx2(const int16_t* a, const int16_t* b, int kpad)
+{
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    for (int k = 0; k < kpad; k += 32) {
+        __m256i a0 = _mm256_loadu_si256((const __m256i*)(a + k));
+        __m256i a1 = _mm256_loadu_si256((const __m256i*)(a + k + 16));
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(a0, _mm256_loadu_si256((const __m256i*)(b + k))));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(a1, _mm256_loadu_si256((const __m256i*)(b + k + 16))));
+    }
+    return hsum_epi32(_mm256_add_epi32(acc0, acc1));
+}
+
+//
+// I16: int16 operands, int32 accumulation
+Result int16_matmul(const vector<double>& a, const vector<double>& b, const vector<double>& ref, int n1, int n2, int n3)
+{
+    const int qmax = int32_safe_qmax(n2, INT16_MAX);
+    auto q = quantize<int16_t, int16_t>(a, b, n1, n2, n3, qmax, qmax);
+    auto dot = __builtin_cpu_supports("avx2") ? dot_i16_avx2 : dot_i16_scalar;
+    vector<int32_t> c((size_t)n1 * n3);
+    double wall_seconds = dot_gemm(dot, q, c);
+
+    bool exact;
+    double err = validate(q, c, ref, exact);
+    if (!exact)
+        std::cerr << "  I16: integer result does not match the exact reference" << std::endl;
+    return {wall_seconds, err};
+}
+
+// --- uint8 x int8 -> int32 kernels ---
+
+int32_t dot_u8i8_scalar(const uint8_t* a, const int8_t* b, int kpad)
+{
+    int32_t sum = 0;
+    for (int k = 0; k < kpad; k++)
+        sum += (int32_t)a[k] * b[k];
+    return sum;
+}
+
+// maddubs forms saturating int16 sums of adjacent u8*s8 pairs; with a <= 127
+// a pair is at most 2 * 127 * 127 and cannot saturate. madd with ones widens to int32.
+__attribute__((target("avx2")))
+int32_t dot_u8i8_avx2(const uint8_t* a, const int8_t* b, int kpad)
+{
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    for (int k = 0; k < kpad; k += 64) {
+        __m256i p0 = _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i*)(a + k)),
+                                          _mm256_loadu_si256((const __m256i*)(b + k)));
+        __m256i p1 = _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i*)(a + k + 32)),
+                                          _mm256_loadu_si256((const __m256i*)(b + k + 32)));
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(p0, ones));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(p1, ones));
+    }
+    return hsum_epi32(_mm256_add_epi32(acc0, acc1));
+}
+
+// dpbusd multiplies groups of four u8*s8 and accumulates straight into int32
+__attribute__((target("avx2,avxvnni")))
+int32_t dot_u8i8_avxvnni(const uint8_t* a, const int8_t* b, int kpad)
+{
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    for (int k = 0; k < kpad; k += 64) {
+        acc0 = _mm256_dpbusd_avx_epi32(acc0, _mm256_loadu_si256((const __m256i*)(a + k)),
+                                       _mm256_loadu_si256((const __m256i*)(b + k)));
+        acc1 = _mm256_dpbusd_avx_epi32(acc1, _mm256_loadu_si256((const __m256i*)(a + k + 32)),
+                                       _mm256_loadu_si256((const __m256i*)(b + k + 32)));
+    }
+    return hsum_epi32(_mm256_add_epi32(acc0, acc1));
+}
+
+__attribute__((target("avx512f,avx512bw,avx512vnni")))
+int32_t dot_u8i8_avx512vnni(const uint8_t* a, const int8_t* b, int kpad)
+{
+    __m512i acc = _mm512_setzero_si512();
+    for (int k = 0; k < kpad; k += 64)
+        acc = _mm512_dpbusd_epi32(acc, _mm512_loadu_si512(a + k), _mm512_loadu_si512(b + k));
+    alignas(64) int32_t lanes[16];
+    _mm512_store_si512(lanes, acc);
+    int32_t sum = 0;
+    for (int l = 0; l < 16; l++)
+        sum += lanes[l];
+    return sum;
+}
+
+//
+// I8: uint8 A (0..127) times int8 B, int32 accumulation. The unsigned operand
+// requires A >= 0, which holds for the [0, 1) test matrices.
+Result int8_matmul(const vector<double>& a, const vector<double>& b, const vector<double>& ref, int n1, int n2, int n3)
+{
+    const int qmax = int32_safe_qmax(n2, INT8_MAX);
+    auto q = quantize<uint8_t, int8_t>(a, b, n1, n2, n3, qmax, qmax);
+    auto dot = __builtin_cpu_supports("avx512vnni") ? dot_u8i8_avx512vnni
+             : __builtin_cpu_supports("avxvnni") ? dot_u8i8_avxvnni
+             : __builtin_cpu_supports("avx2") ? dot_u8i8_avx2 : dot_u8i8_scalar;
+    vector<int32_t> c((size_t)n1 * n3);
+    double wall_seconds = dot_gemm(dot, q, c);
+
+    bool exact;
+    double err = validate(q, c, ref, exact);
+    if (!exact)
+        std::cerr << "  I8: integer result does not match the exact reference" << std::endl;
+    return {wall_seconds, err};
+}
@@ -1,39 +1,148 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <time.h>
-#define SIZE 100
-
-void matrix_multiply(int A[SIZE][SIZE], int B[SIZE][SIZE], int C[SIZE][SIZE]) {
-    int i, j, k;
-    #pragma omp parallel for
-    for (i = 0; i < SIZE; i++) {
-        for (j = 0; j < SIZE; j++) {
-            C[i][j] = 0;
-            for (k = 0; k < SIZE; k++) {
-                C[i][j] += A[i][k] * B[k][j];
-            }
-        }
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define DEFAULT_SIZE 1024
+#define ALIGNMENT 64
+#define COL_BLOCK 256   /* columns of C handled by one task: 1 KB of a row */
+
+/* Wall-clock seconds; clock() would sum CPU time over all threads */
+static double wall_time(void) {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+/* Heap allocation of an n x n matrix, aligned to a cache line */
+static int *alloc_matrix(int n) {
+    size_t bytes = (size_t)n * n * sizeof(int);
+    bytes = (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    int *m = aligned_alloc(ALIGNMENT, bytes);
+    if (m == NULL) {
+        fprintf(stderr, "Unable to allocate %d x %d matrix\n", n, n);
+        exit(1);
     }
+    return m;
+}
+
+/* Stateless counter-based generator (splitmix64): each element's value depends only
+ * on (seed, index), so the initializer is race-free and independent of thread count */
+static inline uint64_t mix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
 }
-int main() {
-    int A[SIZE][SIZE], B[SIZE][SIZE], C[SIZE][SIZE];
+
+/* Parallel initializer: every thread first-touches the rows it writes */
+void initialize_matrices(int *A, int *B, int n, uint64_t seed) {
     int i, j;
-    clock_t start, end;
-    // Initialize matrices with random values
-    srand(time(NULL));
-    #pragma omp parallel for
-    for (i = 0; i < SIZE; i++) {
-        for (j = 0; j < SIZE; j++) {
-            A[i][j] = rand() % 10;
-            B[i][j] = rand() % 10;
+    #pragma omp parallel for private(j) schedule(static)
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < n; j++) {
+            uint64_t idx = (uint64_t)i * n + j;
+            A[idx] = (int)(mix64(seed ^ (2 * idx)) % 10);
+            B[idx] = (int)(mix64(seed ^ (2 * idx + 1)) % 10);
+        }
+    }
+}
+
+/* C = A * B with an i-k-j order: the innermost loop streams contiguous rows of
+ * B and C, so it vectorizes. Rows and column blocks of C are collapsed into one
+ * iteration space, giving every thread disjoint pieces of C to accumulate into. */
+void matrix_multiply(const int *restrict A, const int *restrict B, int *restrict C, int n) {
+    int i, jb;
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (i = 0; i < n; i++) {
+        for (jb = 0; jb < n; jb += COL_BLOCK) {
+            int j_end = jb + COL_BLOCK < n ? jb + COL_BLOCK : n;
+            int *restrict c_row = C + (size_t)i * n;
+            int j, k;
+            for (j = jb; j < j_end; j++)
+                c_row[j] = 0;
+            for (k = 0; k < n; k++) {
+                const int a_ik = A[(size_t)i * n + k];
+                const int *restrict b_row = B + (size_t)k * n;
+                #pragma omp simd
+                for (j = jb; j < j_end; j++)
+                    c_row[j] += a_ik * b_row[j];
+            }
         }
     }
-    // Perform matrix multiplication
-    start = clock();
-    matrix_multiply(A, B, C);
-    end = clock();
-    double time_taken = ((double)(end - start)) / CLOCKS_PER_SEC;
+}
+
+static long long checksum(const int *C, int n) {
+    long long sum = 0;
+    size_t i;
+    for (i = 0; i < (size_t)n * n; i++)
+        sum += C[i];
+    return sum;
+}
+
+/* Best-of-reps wall time of one product */
+static double time_multiply(const int *A, const int *B, int *C, int n, int reps) {
+    double best = -1.0;
+    int r;
+    for (r = 0; r < reps; r++) {
+        double start = wall_time();
+        matrix_multiply(A, B, C, n);
+        double elapsed = wall_time() - start;
+        if (best < 0.0 || elapsed < best)
+            best = elapsed;
+    }
+    return best;
+}
+
+/* Usage: matrix_multiplication [N] [max_threads] [reps] */
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : DEFAULT_SIZE;
+    int reps = argc > 3 ? atoi(argv[3]) : 3;
+    int max_threads = 1;
+#ifdef _OPENMP
+    max_threads = omp_get_num_procs();
+#endif
+    if (argc > 2)
+        max_threads = atoi(argv[2]);
+    if (n <= 0 || max_threads <= 0 || reps <= 0) {
+        fprintf(stderr, "Usage: %s [N] [max_threads] [reps]\n", argv[0]);
+        return 1;
+    }
+
+    int *A = alloc_matrix(n);
+    int *B = alloc_matrix(n);
+    int *C = alloc_matrix(n);
+    initialize_matrices(A, B, n, (uint64_t)time(NULL));
+
+    printf("Matrix size: %d x %d\n", n, n);
+#ifdef _OPENMP
+    /* Thread-scaling sweep; speedup and efficiency are relative to one thread */
+    double t1 = 0.0;
+    int t;
+    for (t = 1; t <= max_threads; t++) {
+        omp_set_num_threads(t);
+        double elapsed = time_multiply(A, B, C, n, reps);
+        if (t == 1)
+            t1 = elapsed;
+        printf("threads=%d time=%f speedup=%.2f efficiency=%.1f%%\n",
+               t, elapsed, t1 / elapsed, 100.0 * t1 / elapsed / t);
+    }
+    omp_set_num_threads(max_threads);
+#endif
+    double time_taken = time_multiply(A, B, C, n, reps);
+    printf("Checksum: %lld\n", checksum(C, n));
     printf("Time taken: %f seconds\n", time_taken);
+
+    free(A);
+    free(B);
+    free(C);
     return 0;
 }
-
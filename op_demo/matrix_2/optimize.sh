@@ -1,16 +1,38 @@
-#!/bin/bash 
+#!/bin/bash
+
+# Matrix size and number of timed repetitions passed to every build
+SIZE=${SIZE:-1024}
+REPS=${REPS:-3}
+MAX_THREADS=${MAX_THREADS:-$(nproc)}
 
 # Clear previous output file if it exists
 > execution_time.txt
 
-# Function to run and time the program
+baseline_time=""
+
+# Function to run a build and report its wall time and speedup over the baseline.
+# The program measures its own wall-clock time, so process start-up and the
+# matrix initialization are not part of the number.
 run_and_time() {
     optimization_name=$1
     executable=$2
 
-    real_time=$( { time ./$executable; } 2>&1 | grep real | awk '{print $2}' )
-    echo "$optimization_name : $real_time"
-    echo "$optimization_name : $real_time" >> execution_time.txt
+    output=$(./$executable $SIZE $MAX_THREADS $REPS)
+    wall_time=$(echo "$output" | grep "Time taken" | awk '{print $3}')
+    if [ -z "$baseline_time" ]; then
+        baseline_time=$wall_time
+    fi
+    speedup=$(awk -v b="$baseline_time" -v t="$wall_time" 'BEGIN { printf "%.2f", b / t }')
+
+    line="$optimization_name : ${wall_time}s (speedup ${speedup}x)"
+    echo "$line"
+    echo "$line" >> execution_time.txt
+
+    # OpenMP builds also print a 1..N thread sweep with speedup and parallel efficiency
+    echo "$output" | grep "^threads=" | while read -r sweep; do
+        echo "    $sweep"
+        echo "    $sweep" >> execution_time.txt
+    done
 }
 
 # Compile the baseline implementation and run the baseline implemenation using run_and_time
@@ -33,5 +55,6 @@ run_and_time "loop vectorization" "matrix_multiplication_lv"
 gcc -O3 -fopenmp matrix_multiplication.c -o matrix_multiplication_mp
 run_and_time "OpenMP parallelization" "matrix_multiplication_mp"
 
-
-
+# The wider flag matrix (-march=native, LTO, PGO, GCC vs Clang) with pinned,
+# repeated runs is available through the generic driver:
+#   ../tools/compare_flags.sh matrix_multiplication.c -- $SIZE 1 1
@@ -0,0 +1,2 @@
+g++ -O3 -march=native -fopenmp -o strassen_matrix_mult strassen_matrix_mult.cpp
+./strassen_matrix_mult 4096
@@ -0,0 +1,414 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include <new>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Strassen-Winograd recursive matrix multiplication for large square matrices.
+// Below the cutoff the recursion switches to the classic blocked (tiled) kernel.
+// All temporaries come out of one preallocated workspace arena; the top
+// `parallel_levels` levels of the recursion run their seven products as OpenMP tasks.
+
+struct StrassenConfig {
+    int cutoff = 128;         // switch to the blocked kernel at or below this size
+    int parallel_levels = 1;  // recursion levels that spawn the seven products as tasks
+    int tile_size = 64;       // tile of the blocked base-case kernel
+};
+
+// One aligned allocation that the whole recursion carves its temporaries from
+class WorkspaceArena {
+public:
+    WorkspaceArena() {}
+    ~WorkspaceArena() { std::free(data_); }
+    WorkspaceArena(const WorkspaceArena&) = delete;
+    WorkspaceArena& operator=(const WorkspaceArena&) = delete;
+
+    // Grow the arena if needed; never shrinks, so repeated products reuse the memory
+    void reserve(std::size_t count) {
+        if (count <= size_)
+            return;
+        std::free(data_);
+        std::size_t bytes = (count * sizeof(double) + 63) / 64 * 64;
+        data_ = static_cast<double*>(std::aligned_alloc(64, bytes));
+        if (data_ == nullptr)
+            throw std::bad_alloc();
+        size_ = count;
+    }
+    double* data() { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    double* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// --- Strided block helpers (ld = leading dimension, row-major) ---
+
+// C = A * B for an n x n block, classic tiled kernel with an i-k-j inner order
+void blocked_multiply(const double* A, int lda, const double* B, int ldb,
+                      double* C, int ldc, int n, int tile_size) {
+    for (int i = 0; i < n; ++i)
+        std::memset(C + (std::size_t)i * ldc, 0, n * sizeof(double));
+
+    for (int bi = 0; bi < n; bi += tile_size) {
+        for (int bk = 0; bk < n; bk += tile_size) {
+            for (int bj = 0; bj < n; bj += tile_size) {
+                int i_end = std::min(bi + tile_size, n);
+                int k_end = std::min(bk + tile_size, n);
+                int j_end = std::min(bj + tile_size, n);
+                for (int i = bi; i < i_end; ++i) {
+                    double* c_row = C + (std::size_t)i * ldc;
+                    for (int k = bk; k < k_end; ++k) {
+                        const double a_ik = A[(std::size_t)i * lda + k];
+                        const double* b_row = B + (std::size_t)k * ldb;
+                        for (int j = bj; j < j_end; ++j)
+                            c_row[j] += a_ik * b_row[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Z = X + Y
+void block_add(const double* X, int ldx, const double* Y, int ldy, double* Z, int ldz, int n) {
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            Z[(std::size_t)i * ldz + j] = X[(std::size_t)i * ldx + j] + Y[(std::size_t)i * ldy + j];
+}
+
+// Z = X - Y
+void block_sub(const double* X, int ldx, const double* Y, int ldy, double* Z, int ldz, int n) {
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            Z[(std::size_t)i * ldz + j] = X[(std::size_t)i * ldx + j] - Y[(std::size_t)i * ldy + j];
+}
+
+// Number of doubles the recursion below a product of size n needs from the arena
+std::size_t strassen_workspace(int n, const StrassenConfig& cfg, int level) {
+    if (n <= cfg.cutoff)
+        return 0;
+    std::size_t h = n / 2;
+    std::size_t hh = h * h;
+    if (level < cfg.parallel_levels) {
+        // S1..S4, T1..T4, P2..P4 plus a private workspace for each of the seven tasks
+        return 11 * hh + 7 * strassen_workspace(n / 2, cfg, level + 1);
+    }
+    // Two temporaries (X, Y) shared by all seven sequential products
+    return 2 * hh + strassen_workspace(n / 2, cfg, level + 1);
+}
+
+void strassen_recursive(const double* A, int lda, const double* B, int ldb,
+                        double* C, int ldc, int n, double* ws,
+                        const StrassenConfig& cfg, int level);
+
+// Memory-frugal Winograd schedule (Boyer, Dumas, Pernet, Zhou): two temporaries,
+// the products are accumulated directly inside the C quadrants
+void strassen_sequential_step(const double* A, int lda, const double* B, int ldb,
+                              double* C, int ldc, int n, double* ws,
+                              const StrassenConfig& cfg, int level) {
+    const int h = n / 2;
+    const double *A11 = A, *A12 = A + h, *A21 = A + (std::size_t)h * lda, *A22 = A21 + h;
+    const double *B11 = B, *B12 = B + h, *B21 = B + (std::size_t)h * ldb, *B22 = B21 + h;
+    double *C11 = C, *C12 = C + h, *C21 = C + (std::size_t)h * ldc, *C22 = C21 + h;
+
+    double* X = ws;
+    double* Y = ws + (std::size_t)h * h;
+    double* child_ws = Y + (std::size_t)h * h;
+
+    block_sub(A11, lda, A21, lda, X, h, h);                                  // S3 = A11 - A21
+    block_sub(B22, ldb, B12, ldb, Y, h, h);                                  // T3 = B22 - B12
+    strassen_recursive(X, h, Y, h, C21, ldc, h, child_ws, cfg, level + 1);  // P7 = S3 T3
+    block_add(A21, lda, A22, lda, X, h, h);                                  // S1 = A21 + A22
+    block_sub(B12, ldb, B11, ldb, Y, h, h);                                  // T1 = B12 - B11
+    strassen_recursive(X, h, Y, h, C22, ldc, h, child_ws, cfg, level + 1);  // P5 = S1 T1
+    block_sub(X, h, A11, lda, X, h, h);                                      // S2 = S1 - A11
+    block_sub(B22, ldb, Y, h, Y, h, h);                                      // T2 = B22 - T1
+    strassen_recursive(X, h, Y, h, C12, ldc, h, child_ws, cfg, level + 1);  // P6 = S2 T2
+    block_sub(A12, lda, X, h, X, h, h);                                      // S4 = A12 - S2
+    strassen_recursive(X, h, B22, ldb, C11, ldc, h, child_ws, cfg, level + 1); // P3 = S4 B22
+    strassen_recursive(A11, lda, B11, ldb, X, h, h, child_ws, cfg, level + 1); // P1 = A11 B11
+    block_add(X, h, C12, ldc, C12, ldc, h);                                  // U2 = P1 + P6
+    block_add(C12, ldc, C21, ldc, C21, ldc, h);                              // U3 = U2 + P7
+    block_add(C12, ldc, C22, ldc, C12, ldc, h);                              // U4 = U2 + P5
+    block_add(C21, ldc, C22, ldc, C22, ldc, h);                              // U7 = U3 + P5
+    block_add(C12, ldc, C11, ldc, C12, ldc, h);                              // U5 = U4 + P3
+    block_sub(Y, h, B21, ldb, Y, h, h);                                      // T4 = T2 - B21
+    strassen_recursive(A22, lda, Y, h, C11, ldc, h, child_ws, cfg, level + 1); // P4 = A22 T4
+    block_sub(C21, ldc, C11, ldc, C21, ldc, h);                              // U6 = U3 - P4
+    strassen_recursive(A12, lda, B21, ldb, C11, ldc, h, child_ws, cfg, level + 1); // P2 = A12 B21
+    block_add(X, h, C11, ldc, C11, ldc, h);                                  // U1 = P1 + P2
+}
+
+// Task-parallel step: all operand sums are formed first, then the seven
+// products run as independent tasks, each in its own slice of the arena
+void strassen_parallel_step(const double* A, int lda, const double* B, int ldb,
+                            double* C, int ldc, int n, double* ws,
+                            const StrassenConfig& cfg, int level) {
+    const int h = n / 2;
+    const std::size_t hh = (std::size_t)h * h;
+    const double *A11 = A, *A12 = A + h, *A21 = A + (std::size_t)h * lda, *A22 = A21 + h;
+    const double *B11 = B, *B12 = B + h, *B21 = B + (std::size_t)h * ldb, *B22 = B21 + h;
+    double *C11 = C, *C12 = C + h, *C21 = C + (std::size_t)h * ldc, *C22 = C21 + h;
+
+    double *S1 = ws, *S2 = S1 + hh, *S3 = S2 + hh, *S4 = S3 + hh;
+    double *T1 = S4 + hh, *T2 = T1 + hh, *T3 = T2 + hh, *T4 = T3 + hh;
+    double *P2 = T4 + hh, *P3 = P2 + hh, *P4 = P3 + hh;
+    double* child_ws = P4 + hh;
+    const std::size_t child_size = strassen_workspace(h, cfg, level + 1);
+
+    block_add(A21, lda, A22, lda, S1, h, h);
+    block_sub(S1, h, A11, lda, S2, h, h);
+    block_sub(A11, lda, A21, lda, S3, h, h);
+    block_sub(A12, lda, S2, h, S4, h, h);
+    block_sub(B12, ldb, B11, ldb, T1, h, h);
+    block_sub(B22, ldb, T1, h, T2, h, h);
+    block_sub(B22, ldb, B12, ldb, T3, h, h);
+    block_sub(T2, h, B21, ldb, T4, h, h);
+
+    #pragma omp task
+    strassen_recursive(A11, lda, B11, ldb, C11, ldc, h, child_ws + 0 * child_size, cfg, level + 1); // P1
+    #pragma omp task
+    strassen_recursive(A12, lda, B21, ldb, P2, h, h, child_ws + 1 * child_size, cfg, level + 1);
+    #pragma omp task
+    strassen_recursive(S4, h, B22, ldb, P3, h, h, child_ws + 2 * child_size, cfg, level + 1);
+    #pragma omp task
+    strassen_recursive(A22, lda, T4, h, P4, h, h, child_ws + 3 * child_size, cfg, level + 1);
+    #pragma omp task
+    strassen_recursive(S1, h, T1, h, C22, ldc, h, child_ws + 4 * child_size, cfg, level + 1);  // P5
+    #pragma omp task
+    strassen_recursive(S2, h, T2, h, C12, ldc, h, child_ws + 5 * child_size, cfg, level + 1);  // P6
+    #pragma omp task
+    strassen_recursive(S3, h, T3, h, C21, ldc, h, child_ws + 6 * child_size, cfg, level + 1);  // P7
+    #pragma omp taskwait
+
+    // Combine element-wise; every output only depends on inputs at the same position
+    for (int i = 0; i < h; ++i) {
+        for (int j = 0; j < h; ++j) {
+            const std::size_t c = (std::size_t)i * ldc + j;
+            const std::size_t p = (std::size_t)i * h + j;
+            const double p1 = C11[c], p5 = C22[c], p6 = C12[c], p7 = C21[c];
+            const double u2 = p1 + p6;
+            const double u3 = u2 + p7;
+            C11[c] = p1 + P2[p];
+            C12[c] = u2 + p5 + P3[p];
+            C21[c] = u3 - P4[p];
+            C22[c] = u3 + p5;
+        }
+    }
+}
+
+void strassen_recursive(const double* A, int lda, const double* B, int ldb,
+                        double* C, int ldc, int n, double* ws,
+                        const StrassenConfig& cfg, int level) {
+    if (n <= cfg.cutoff) {
+        blocked_multiply(A, lda, B, ldb, C, ldc, n, cfg.tile_size);
+        return;
+    }
+    if (level < cfg.parallel_levels)
+        strassen_parallel_step(A, lda, B, ldb, C, ldc, n, ws, cfg, level);
+    else
+        strassen_sequential_step(A, lda, B, ldb, C, ldc, n, ws, cfg, level);
+}
+
+// Number of halvings until a size n product falls to the cutoff
+int strassen_levels(int n, int cutoff) {
+    int levels = 0;
+    while ((n + (1 << levels) - 1) >> levels > cutoff)
+        ++levels;
+    return levels;
+}
+
+// Smallest size >= n that halves evenly down to a base case no larger than the cutoff
+int strassen_padded_size(int n, int cutoff) {
+    int levels = strassen_levels(n, cutoff);
+    int base = (n + (1 << levels) - 1) >> levels;
+    return base << levels;
+}
+
+// Size of the arena one strassen_multiply() call of size n needs
+std::size_t strassen_arena_size(int n, const StrassenConfig& cfg) {
+    int np = strassen_padded_size(n, cfg.cutoff);
+    std::size_t padding = (np != n) ? 3 * (std::size_t)np * np : 0;
+    return padding + strassen_workspace(np, cfg, 0);
+}
+
+// C = A * B (n x n, row-major). Sizes that do not halve evenly are zero-padded
+// inside the arena.
+void strassen_multiply(const double* A, const double* B, double* C, int n,
+                       const StrassenConfig& cfg, WorkspaceArena& arena) {
+    arena.reserve(strassen_arena_size(n, cfg));
+    const int np = strassen_padded_size(n, cfg.cutoff);
+    double* ws = arena.data();
+
+    const double* Ap = A;
+    const double* Bp = B;
+    double* Cp = C;
+    if (np != n) {
+        const std::size_t nn = (std::size_t)np * np;
+        double* Apad = ws;
+        double* Bpad = ws + nn;
+        Cp = ws + 2 * nn;
+        ws += 3 * nn;
+        std::memset(Apad, 0, 2 * nn * sizeof(double));
+        for (int i = 0; i < n; ++i) {
+            std::memcpy(Apad + (std::size_t)i * np, A + (std::size_t)i * n, n * sizeof(double));
+            std::memcpy(Bpad + (std::size_t)i * np, B + (std::size_t)i * n, n * sizeof(double));
+        }
+        Ap = Apad;
+        Bp = Bpad;
+    }
+
+    #pragma omp parallel
+    #pragma omp single
+    strassen_recursive(Ap, np, Bp, np, Cp, np, np, ws, cfg, 0);
+
+    if (np != n) {
+        for (int i = 0; i < n; ++i)
+            std::memcpy(C + (std::size_t)i * n, Cp + (std::size_t)i * np, n * sizeof(double));
+    }
+}
+
+// Pick the fastest cutoff for this machine by timing a probe product
+int tune_cutoff(const double* A, const double* B, double* C, int probe_n,
+                StrassenConfig cfg, WorkspaceArena& arena) {
+    const int candidates[] = {64, 128, 256, 512};
+    int best_cutoff = candidates[0];
+    double best_time = -1.0;
+
+    for (int cutoff : candidates) {
+        if (cutoff >= probe_n)
+            break;
+        cfg.cutoff = cutoff;
+        auto start = std::chrono::steady_clock::now();
+        strassen_multiply(A, B, C, probe_n, cfg, arena);
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed = end - start;
+        std::cout << "  cutoff " << std::setw(4) << cutoff << ": " << elapsed.count() << " seconds" << std::endl;
+        if (best_time < 0.0 || elapsed.count() < best_time) {
+            best_time = elapsed.count();
+            best_cutoff = cutoff;
+        }
+    }
+    return best_cutoff;
+}
+
+double max_abs(const double* X, std::size_t count) {
+    double m = 0.0;
+    for (std::size_t i = 0; i < count; ++i)
+        m = std::max(m, std::fabs(X[i]));
+    return m;
+}
+
+// Observed error of the Strassen-Winograd product against the classical one,
+// next to the first-order forward error bounds (Higham, "Accuracy and Stability
+// of Numerical Algorithms", 2nd ed., §23.2), all in the max norm
+void report_error(const double* A, const double* B, const double* C_ref,
+                  const double* C, int n, int cutoff) {
+    const std::size_t nn = (std::size_t)n * n;
+    double max_diff = 0.0;
+    for (std::size_t i = 0; i < nn; ++i)
+        max_diff = std::max(max_diff, std::fabs(C[i] - C_ref[i]));
+
+    const double u = std::ldexp(1.0, -53);
+    const double norm_ab = max_abs(A, nn) * max_abs(B, nn);
+    const int np = strassen_padded_size(n, cutoff);
+    const double n0 = static_cast<double>(np >> strassen_levels(n, cutoff));
+    const double ratio = np / n0;
+    const double classical_bound = (double)n * n * u;
+    const double winograd_bound = (std::pow(ratio, std::log2(18.0)) * (n0 * n0 + 6.0 * n0) - 6.0 * np) * u;
+
+    std::cout << std::scientific << std::setprecision(3);
+    std::cout << "Max |C_strassen - C_classical|: " << max_diff << std::endl;
+    std::cout << "Normwise error / (|A||B|):      " << max_diff / norm_ab << std::endl;
+    std::cout << "Classical bound  (n^2 u):        " << classical_bound << std::endl;
+    std::cout << "Winograd bound   (n0 = " << (int)n0 << "):     " << winograd_bound << std::endl;
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
+
+void initialize_matrices(double* A, double* B, int N) {
+    srand(1325);
+    for (std::size_t i = 0; i < (std::size_t)N * N; i++)
+        A[i] = static_cast<double>(rand()) / RAND_MAX;
+    for (std::size_t i = 0; i < (std::size_t)N * N; i++)
+        B[i] = static_cast<double>(rand()) / RAND_MAX;
+}
+
+// Usage: strassen_matrix_mult [N] [cutoff]   (cutoff 0 = tune on this machine)
+int main(int argc, char* argv[]) {
+    const int N = argc > 1 ? std::atoi(argv[1]) : 2048;
+    const int fixed_cutoff = argc > 2 ? std::atoi(argv[2]) : 0;
+    if (N <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [N] [cutoff]" << std::endl;
+        return 1;
+    }
+
+    std::vector<double> A((std::size_t)N * N), B((std::size_t)N * N);
+    std::vector<double> C_ref((std::size_t)N * N), C((std::size_t)N * N);
+    initialize_matrices(A.data(), B.data(), N);
+
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    std::cout << "Matrix size: " << N << " x " << N << ", threads: " << threads << std::endl;
+    const double flops = 2.0 * N * (double)N * N;
+
+    // Classical blocked product, the reference for both timing and accuracy
+    auto start = std::chrono::steady_clock::now();
+    blocked_multiply(A.data(), N, B.data(), N, C_ref.data(), N, N, 64);
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> classical_elapsed = end - start;
+    std::cout << "Classical blocked time: " << classical_elapsed.count() << " seconds ("
+              << flops / classical_elapsed.count() / 1e9 << " GFLOP/s)" << std::endl;
+    std::cout << "Verification checksum: " << C_ref[0] + C_ref[(std::size_t)N * N - 1] << std::endl;
+    std::cout << std::endl;
+
+    WorkspaceArena arena;
+    StrassenConfig cfg;
+    cfg.parallel_levels = threads > 1 ? 2 : 0;
+
+    if (fixed_cutoff > 0) {
+        cfg.cutoff = fixed_cutoff;
+    } else {
+        const int probe_n = std::min(N, 1024);
+        std::cout << "Tuning cutoff on a " << probe_n << " x " << probe_n << " product" << std::endl;
+        cfg.cutoff = tune_cutoff(A.data(), B.data(), C.data(), probe_n, cfg, arena);
+    }
+    std::cout << "Cutoff: " << cfg.cutoff << ", parallel levels: " << cfg.parallel_levels
+              << ", arena: " << strassen_arena_size(N, cfg) * sizeof(double) / (1024.0 * 1024.0) << " MB" << std::endl;
+
+    // Sequential recursion
+    StrassenConfig seq_cfg = cfg;
+    seq_cfg.parallel_levels = 0;
+    start = std::chrono::steady_clock::now();
+    strassen_multiply(A.data(), B.data(), C.data(), N, seq_cfg, arena);
+    end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> seq_elapsed = end - start;
+    std::cout << "Strassen-Winograd (sequential) time: " << seq_elapsed.count() << " seconds, speedup "
+              << classical_elapsed.count() / seq_elapsed.count() << "x" << std::endl;
+
+    // Task-parallel recursion
+    if (cfg.parallel_levels > 0) {
+        start = std::chrono::steady_clock::now();
+        strassen_multiply(A.data(), B.data(), C.data(), N, cfg, arena);
+        end = std::chrono::steady_clock::now();
+        std::chrono::duration<double> par_elapsed = end - start;
+        std::cout << "Strassen-Winograd (tasks) time: " << par_elapsed.count() << " seconds, speedup "
+                  << classical_elapsed.count() / par_elapsed.count() << "x" << std::endl;
+    }
+    std::cout << "Verification checksum: " << C[0] + C[(std::size_t)N * N - 1] << std::endl;
+    std::cout << std::endl;
+
+    report_error(A.data(), B.data(), C_ref.data(), C.data(), N, cfg.cutoff);
+
+    return 0;
+}
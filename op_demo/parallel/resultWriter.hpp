@@ -0,0 +1,189 @@
+#ifndef RESULT_WRITER_HPP
+#define RESULT_WRITER_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <charconv>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "sumSquaresFast.hpp"
+
+// Buffered output for sumOfSquares results.
+//
+// Results are formatted with std::to_chars straight into a large reusable buffer
+// and handed to the kernel in big write(2) calls, instead of one flush per line
+// through iostreams. When stdout is a pipe the buffer can be spliced into it with
+// vmsplice(2) instead of copied. A fixed-size binary record format is available
+// for consumers that do not need text.
+
+enum class ResultFormat { Text, Binary };
+
+// Binary format: the 8-byte magic, then one record per result
+const char kResultMagic[8] = {'S', 'S', 'Q', 'R', 'E', 'S', '0', '1'};
+
+struct ResultRecord {
+    uint64_t n;
+    uint64_t lo;        // low 64 bits of the result
+    uint64_t hi;        // high 64 bits of the result
+    uint64_t flags;     // bit 0: the result needs more than 128 bits (lo/hi are 0);
+                        //        recompute it with sumOfSquaresExact(n)
+};
+
+// Decimal digits of an unsigned 128-bit value; returns the end of the written text
+inline char* appendDecimal(char* out, uint128 v) {
+    const uint64_t kTen19 = 10000000000000000000ULL;
+    if ((v >> 64) == 0)
+        return std::to_chars(out, out + 20, static_cast<uint64_t>(v)).ptr;
+    // Up to 39 digits: high part, then the low 19 digits zero-padded
+    char* p = appendDecimal(out, v / kTen19);
+    uint64_t low = static_cast<uint64_t>(v % kTen19);
+    for (int d = 18; d >= 0; --d) {
+        p[d] = static_cast<char>('0' + low % 10);
+        low /= 10;
+    }
+    return p + 19;
+}
+
+class ResultWriter {
+public:
+    // vmsplice is only used when requested and fd is a pipe
+    ResultWriter(int fd, ResultFormat format, bool useVmsplice = false, std::size_t capacity = 1 << 20)
+        : fd_(fd), format_(format), capacity_(capacity) {
+        struct stat st;
+        if (useVmsplice && fstat(fd, &st) == 0 && S_ISFIFO(st.st_mode)) {
+            int pipeSize = fcntl(fd, F_GETPIPE_SZ);
+            if (pipeSize > 0) {
+                // A spliced buffer is only reusable once the reader has consumed it. A
+                // pipe holds at most pipeSize bytes, so after two later buffers of that
+                // size went in completely, the oldest one has been read.
+                vmsplice_ = true;
+                capacity_ = static_cast<std::size_t>(pipeSize);
+            }
+        }
+        // Buffers are mapped rather than heap-allocated: pages spliced into a pipe stay
+        // referenced by the pipe after munmap, whereas freed heap memory is reused at once
+        for (int b = 0; b < (vmsplice_ ? 3 : 1); ++b) {
+            void* p = mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+                throw std::bad_alloc();
+            buffers_.push_back(static_cast<char*>(p));
+        }
+        if (format_ == ResultFormat::Binary)
+            append(kResultMagic, sizeof(kResultMagic));
+    }
+
+    ~ResultWriter() {
+        flush();
+        for (char* buf : buffers_)
+            munmap(buf, capacity_);
+    }
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    // Text lines read "<prefix><N><separator><result>"
+    void setLineFormat(const std::string& prefix, const std::string& separator) {
+        prefix_ = prefix;
+        separator_ = separator;
+    }
+
+    void add(unsigned long long N, const SumOfSquares& r) {
+        if (format_ == ResultFormat::Binary) {
+            ResultRecord rec;
+            rec.n = N;
+            rec.lo = r.overflow ? 0 : static_cast<uint64_t>(r.value);
+            rec.hi = r.overflow ? 0 : static_cast<uint64_t>(r.value >> 64);
+            rec.flags = r.overflow ? 1 : 0;
+            append(reinterpret_cast<const char*>(&rec), sizeof(rec));
+            return;
+        }
+
+        if (r.overflow) {
+            std::string big = sumOfSquaresExact(N).toString();
+            appendText(N, big.data(), big.size());
+            return;
+        }
+        // prefix + 20 digits of N + separator + 39 digits + '\n'
+        reserve(prefix_.size() + separator_.size() + 61);
+        char* p = cursor();
+        std::memcpy(p, prefix_.data(), prefix_.size());
+        p = std::to_chars(p + prefix_.size(), p + prefix_.size() + 20, N).ptr;
+        std::memcpy(p, separator_.data(), separator_.size());
+        p = appendDecimal(p + separator_.size(), r.value);
+        *p++ = '\n';
+        pos_ = static_cast<std::size_t>(p - buffers_[current_]);
+    }
+
+    // Hand the buffered bytes to the kernel
+    void flush() {
+        if (pos_ == 0)
+            return;
+        const char* data = buffers_[current_];
+        std::size_t size = pos_;
+        while (size > 0) {
+            ssize_t n;
+            if (vmsplice_) {
+                struct iovec iov = {const_cast<char*>(data), size};
+                n = vmsplice(fd_, &iov, 1, 0);
+            } else {
+                n = write(fd_, data, size);
+            }
+            if (n <= 0) {
+                std::perror(vmsplice_ ? "vmsplice" : "write");
+                break;
+            }
+            data += n;
+            size -= static_cast<std::size_t>(n);
+        }
+        bytesWritten_ += pos_;
+        pos_ = 0;
+        if (vmsplice_)
+            current_ = (current_ + 1) % buffers_.size();
+    }
+
+    std::size_t bytesWritten() const { return bytesWritten_ + pos_; }
+
+private:
+    char* cursor() { return buffers_[current_] + pos_; }
+
+    void reserve(std::size_t bytes) {
+        if (pos_ + bytes > capacity_)
+            flush();
+    }
+
+    void append(const char* data, std::size_t size) {
+        reserve(size);
+        std::memcpy(cursor(), data, size);
+        pos_ += size;
+    }
+
+    void appendText(unsigned long long N, const char* result, std::size_t length) {
+        append(prefix_.data(), prefix_.size());
+        char digits[24];
+        char* end = std::to_chars(digits, digits + sizeof(digits), N).ptr;
+        append(digits, static_cast<std::size_t>(end - digits));
+        append(separator_.data(), separator_.size());
+        append(result, length);
+        append("\n", 1);
+    }
+
+    int fd_;
+    ResultFormat format_;
+    std::size_t capacity_;
+    bool vmsplice_ = false;
+    std::vector<char*> buffers_;
+    std::size_t current_ = 0;
+    std::size_t pos_ = 0;
+    std::size_t bytesWritten_ = 0;
+    std::string prefix_ = "Result for ";
+    std::string separator_ = ": ";
+};
+
+#endif
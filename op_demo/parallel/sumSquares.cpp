@@ -1,40 +1,337 @@
 #include <iostream>
-#include <fstream>
+#include <iomanip>
 #include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <charconv>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <fcntl.h>
+#include <glob.h>
+#include <unistd.h>
+#include "sumSquaresFast.hpp"
+#include "resultWriter.hpp"
 
-// Function to calculate the sum of squares from 1 to N
-unsigned long long sumOfSquares(unsigned long long N) {
-    unsigned long long sum = 0;
-    for (unsigned long long i = 1; i <= N; ++i) {
-        sum += i * i;
+// Sum of squares for every N in a set of input files.
+//
+// Inputs may be files, directories (every regular file inside) or glob patterns.
+// A pool of reader threads takes files off a shared list, parses them with
+// std::from_chars and pushes batches of values onto a bounded queue; compute
+// workers evaluate the closed form; a single writer thread emits each file's
+// results in input order. Readers block when the queue is full, so memory stays
+// bounded however far the I/O runs ahead of the compute.
+
+const std::size_t kReadBytes = 1 << 20;     // read(2) size per call
+const std::size_t kBatchValues = 4096;      // values per queued batch
+
+// --- Bounded queue ---
+
+// Blocking FIFO with a fixed capacity: push waits while full, pop waits while
+// empty. After close(), pop drains what is left and then returns false.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity) : capacity_(capacity) {}
+
+    void push(T&& item) {
+        std::unique_lock<std::mutex> locker(mu_);
+        notFull_.wait(locker, [this]() { return items_.size() < capacity_; });
+        items_.push_back(std::move(item));
+        locker.unlock();
+        notEmpty_.notify_one();
     }
-    return sum;
-}
 
-// Function to process a single file
-void processFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (file.is_open()) {
-        long long N;
-        while (file >> N) {
-            unsigned long long result = sumOfSquares(N);
-            std::cout << "Result for " << filename << " (N = " << N << "): " << result << std::endl;
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> locker(mu_);
+        notEmpty_.wait(locker, [this]() { return !items_.empty() || closed_; });
+        if (items_.empty())
+            return false;
+        item = std::move(items_.front());
+        items_.pop_front();
+        locker.unlock();
+        notFull_.notify_one();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> locker(mu_);
+            closed_ = true;
         }
-        file.close();
-        file >> N;
+        notEmpty_.notify_all();
+    }
+
+private:
+    std::mutex mu_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+    std::deque<T> items_;
+    std::size_t capacity_;
+    bool closed_ = false;
+};
+
+// --- Inputs ---
+
+struct InputFile {
+    std::string path;
+    std::size_t bytes = 0;
+    std::size_t values = 0;
+    std::chrono::steady_clock::time_point start;   // first read
+    std::chrono::steady_clock::time_point end;     // last result written
+    bool opened = false;
+};
+
+// One slice of a file; seq orders the batches of a file, last marks its final one
+struct Batch {
+    std::size_t file = 0;
+    std::size_t seq = 0;
+    bool last = false;
+    std::vector<unsigned long long> values;
+    std::vector<SumOfSquares> results;
+};
+
+// Function to expand the command-line inputs: directories list their regular
+// files in name order, glob patterns their matches, anything else is taken as is
+std::vector<std::string> expandInputs(const std::vector<std::string>& args) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> paths;
+    for (const std::string& arg : args) {
+        std::error_code ec;
+        if (fs::is_directory(arg, ec)) {
+            std::vector<std::string> entries;
+            for (const fs::directory_entry& entry : fs::directory_iterator(arg, ec))
+                if (entry.is_regular_file(ec))
+                    entries.push_back(entry.path().string());
+            std::sort(entries.begin(), entries.end());
+            paths.insert(paths.end(), entries.begin(), entries.end());
+        } else if (arg.find_first_of("*?[") != std::string::npos) {
+            glob_t matches;
+            if (glob(arg.c_str(), 0, nullptr, &matches) == 0) {
+                for (std::size_t i = 0; i < matches.gl_pathc; ++i)
+                    paths.push_back(matches.gl_pathv[i]);
+            } else {
+                std::cerr << "No match for pattern: " << arg << std::endl;
+            }
+            globfree(&matches);
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    return paths;
+}
+
+// --- Reader stage ---
+
+// Function to read one file in large blocks and queue its values in batches.
+// A number split across two reads is carried over to the next one; malformed
+// tokens are skipped.
+void readFile(std::size_t index, InputFile& input, BoundedQueue<Batch>& parsed) {
+    Batch batch;
+    batch.file = index;
+    batch.values.reserve(kBatchValues);
+
+    input.start = std::chrono::steady_clock::now();
+    int fd = open(input.path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Unable to open file: " << input.path << std::endl;
     } else {
-        std::cerr << "Unable to open file: " << filename << std::endl;
+        input.opened = true;
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        std::vector<char> buf(kReadBytes + 32);
+        std::size_t carry = 0;
+        bool skipping = false;   // inside an over-long token that began in an earlier block
+        while (true) {
+            ssize_t n = read(fd, buf.data() + carry, kReadBytes);
+            if (n < 0) {
+                std::perror(input.path.c_str());
+                break;
+            }
+            input.bytes += static_cast<std::size_t>(n);
+            const bool eof = n == 0;
+            const char* p = buf.data();
+            const char* end = buf.data() + carry + n;
+            if (skipping) {
+                while (p < end && !(*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+                    ++p;
+                skipping = p == end;
+            }
+            while (true) {
+                while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+                    ++p;
+                const char* token = p;
+                while (p < end && !(*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+                    ++p;
+                if (p == end && !eof)
+                    break;   // the token may continue in the next block
+                if (token == p)
+                    break;
+                unsigned long long N = 0;
+                auto parsed_value = std::from_chars(token, p, N);
+                if (parsed_value.ec == std::errc() && parsed_value.ptr == p) {
+                    batch.values.push_back(N);
+                    if (batch.values.size() == kBatchValues) {
+                        input.values += batch.values.size();
+                        Batch next;
+                        next.file = index;
+                        next.seq = batch.seq + 1;
+                        next.values.reserve(kBatchValues);
+                        parsed.push(std::move(batch));
+                        batch = std::move(next);
+                    }
+                }
+            }
+            if (eof)
+                break;
+            if (skipping) {
+                carry = 0;
+                continue;
+            }
+            // Move the unfinished token to the front of the buffer
+            const char* token = p;
+            while (token > buf.data() + 0 && token[-1] != ' ' && token[-1] != '\n' && token[-1] != '\r' && token[-1] != '\t')
+                --token;
+            carry = static_cast<std::size_t>(end - token);
+            if (carry > 32) {
+                std::cerr << "Token too long in " << input.path << std::endl;
+                carry = 0;
+                skipping = true;   // drop the rest of it as well
+            }
+            std::memmove(buf.data(), token, carry);
+        }
+        close(fd);
+    }
+    // Always send a final batch so the writer learns that the file is complete
+    input.values += batch.values.size();
+    batch.last = true;
+    parsed.push(std::move(batch));
+}
+
+// --- Writer stage ---
+
+// Function to emit batches strictly in sequence order per file. Batches of
+// different files interleave; every line carries its file name.
+void writeResults(std::vector<InputFile>& inputs, BoundedQueue<Batch>& computed, ResultWriter& out) {
+    std::vector<std::size_t> nextSeq(inputs.size(), 0);
+    std::vector<std::map<std::size_t, Batch>> pending(inputs.size());
+    Batch batch;
+    while (computed.pop(batch)) {
+        const std::size_t f = batch.file;
+        pending[f].emplace(batch.seq, std::move(batch));
+        auto it = pending[f].begin();
+        while (it != pending[f].end() && it->first == nextSeq[f]) {
+            Batch& ready = it->second;
+            out.setLineFormat("Result for " + inputs[f].path + " (N = ", "): ");
+            for (std::size_t i = 0; i < ready.values.size(); ++i)
+                out.add(ready.values[i], ready.results[i]);
+            if (ready.last)
+                inputs[f].end = std::chrono::steady_clock::now();
+            ++nextSeq[f];
+            it = pending[f].erase(it);
+        }
+    }
+    out.flush();
+}
+
+// Function to report the throughput of every file and of the whole run
+void reportThroughput(const std::vector<InputFile>& inputs, double seconds) {
+    std::size_t bytes = 0, values = 0;
+    std::cerr << std::fixed << std::setprecision(3);
+    for (const InputFile& input : inputs) {
+        if (!input.opened)
+            continue;
+        std::chrono::duration<double> elapsed = input.end - input.start;
+        const double s = std::max(elapsed.count(), 1e-9);
+        std::cerr << input.path << ": " << input.values << " values, " << input.bytes / 1e6 << " MB in "
+                  << s << " s (" << input.bytes / 1e6 / s << " MB/s, " << input.values / s / 1e6 << " M values/s)" << std::endl;
+        bytes += input.bytes;
+        values += input.values;
     }
+    std::cerr << "Total: " << inputs.size() << " files, " << values << " values, " << bytes / 1e6 << " MB in "
+              << seconds << " s (" << bytes / 1e6 / seconds << " MB/s)" << std::endl;
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <filename>" << std::endl;
+    ResultFormat format = ResultFormat::Text;
+    bool useVmsplice = false;
+    unsigned readers = 4;
+    unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t queueBatches = 64;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--binary")
+            format = ResultFormat::Binary;
+        else if (arg == "--vmsplice")
+            useVmsplice = true;
+        else if (arg == "--readers" && i + 1 < argc)
+            readers = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--workers" && i + 1 < argc)
+            workers = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--queue" && i + 1 < argc)
+            queueBatches = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+        else
+            args.push_back(arg);
+    }
+    if (args.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--binary] [--vmsplice] [--readers R] [--workers W] [--queue B]"
+                  << " <file|directory|'glob'>..." << std::endl;
         return 1;
     }
 
-    std::string filename = argv[1];
-    processFile(filename);
+    std::vector<InputFile> inputs;
+    for (const std::string& path : expandInputs(args)) {
+        inputs.emplace_back();
+        inputs.back().path = path;
+    }
+    readers = std::min<unsigned>(readers, static_cast<unsigned>(std::max<std::size_t>(inputs.size(), 1)));
+
+    auto start = std::chrono::steady_clock::now();
+    BoundedQueue<Batch> parsed(queueBatches);
+    BoundedQueue<Batch> computed(queueBatches);
+    ResultWriter out(STDOUT_FILENO, format, useVmsplice);
+
+    // Shared I/O pool: each reader claims the next unread file
+    std::atomic<std::size_t> nextFile{0};
+    std::vector<std::thread> readerThreads;
+    for (unsigned r = 0; r < readers; ++r) {
+        readerThreads.emplace_back([&]() {
+            for (std::size_t f; (f = nextFile.fetch_add(1)) < inputs.size();)
+                readFile(f, inputs[f], parsed);
+        });
+    }
+
+    // Compute workers: O(1) closed form per value, arbitrary precision on overflow
+    // is left to the writer's formatting
+    std::vector<std::thread> workerThreads;
+    for (unsigned w = 0; w < workers; ++w) {
+        workerThreads.emplace_back([&]() {
+            Batch batch;
+            while (parsed.pop(batch)) {
+                batch.results.resize(batch.values.size());
+                sumOfSquaresBatch(batch.values.data(), batch.values.size(), batch.results.data());
+                computed.push(std::move(batch));
+            }
+        });
+    }
+
+    std::thread writer(writeResults, std::ref(inputs), std::ref(computed), std::ref(out));
+
+    for (std::thread& t : readerThreads)
+        t.join();
+    parsed.close();
+    for (std::thread& t : workerThreads)
+        t.join();
+    computed.close();
+    writer.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
 
+    reportThroughput(inputs, elapsed.count());
     return 0;
 }
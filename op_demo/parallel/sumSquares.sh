@@ -1,12 +1,14 @@
 #!/bin/bash
 
 # Compile the C++ program
-g++ -o sumSquares sumSquares.cpp
+g++ -std=c++17 -O2 -pthread -o sumSquares sumSquares.cpp
 
 # Measure start time
 start=$(date +%s.%N)
 
 # Execute the program with the provided filename
+# (also accepts several files, directories and quoted globs, e.g. 'shards/*.txt';
+# --binary writes fixed-size records; --vmsplice splices the output buffers into a pipe)
 ./sumSquares data.txt
 
 # Measure end time
@@ -0,0 +1,279 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "sumSquaresFast.hpp"
+#include "resultWriter.hpp"
+
+// In-process replacement for `cat data.txt | parallel -j+0 ./sumSquaresParallel {}`.
+//
+// The input file is memory-mapped and cut into newline-aligned chunks. A
+// work-stealing pool sized to the cores parses each chunk with std::from_chars,
+// evaluates the closed form and formats the results into a per-chunk buffer. A
+// writer stage emits the chunk buffers strictly in input order.
+
+const std::size_t kChunkBytes = 64 * 1024;
+
+// --- Work-stealing thread pool ---
+
+// Every worker owns a deque: it takes work from the front of its own deque and,
+// when that runs dry, steals from the back of a random victim's deque.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned threads) : queues_(threads) {
+        for (unsigned t = 0; t < threads; ++t)
+            queues_[t].reset(new WorkQueue);
+    }
+
+    // Run task(i) for every i in [0, count); initial work is dealt out in contiguous ranges
+    void run(std::size_t count, const std::function<void(std::size_t)>& task) {
+        const std::size_t threads = queues_.size();
+        for (std::size_t t = 0; t < threads; ++t) {
+            for (std::size_t i = count * t / threads; i < count * (t + 1) / threads; ++i)
+                queues_[t]->tasks.push_back(i);
+        }
+        remaining_.store(count, std::memory_order_relaxed);
+
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t)
+            workers.emplace_back(&WorkStealingPool::worker, this, t, std::cref(task));
+        for (std::thread& w : workers)
+            w.join();
+    }
+
+private:
+    struct WorkQueue {
+        std::mutex mu;
+        std::deque<std::size_t> tasks;
+    };
+
+    bool pop_local(std::size_t self, std::size_t& item) {
+        WorkQueue& q = *queues_[self];
+        std::lock_guard<std::mutex> locker(q.mu);
+        if (q.tasks.empty())
+            return false;
+        item = q.tasks.front();
+        q.tasks.pop_front();
+        return true;
+    }
+
+    bool steal(std::size_t victim, std::size_t& item) {
+        WorkQueue& q = *queues_[victim];
+        std::lock_guard<std::mutex> locker(q.mu);
+        if (q.tasks.empty())
+            return false;
+        item = q.tasks.back();
+        q.tasks.pop_back();
+        return true;
+    }
+
+    void worker(std::size_t self, const std::function<void(std::size_t)>& task) {
+        std::minstd_rand rng(static_cast<unsigned>(self) + 1);
+        const std::size_t threads = queues_.size();
+        std::size_t item;
+        while (remaining_.load(std::memory_order_acquire) > 0) {
+            bool found = pop_local(self, item);
+            for (std::size_t attempt = 0; !found && attempt < threads; ++attempt)
+                found = steal(rng() % threads, item);
+            if (!found) {
+                std::this_thread::yield();
+                continue;
+            }
+            task(item);
+            remaining_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::atomic<std::size_t> remaining_{0};
+};
+
+// --- Ordered output stage ---
+
+// Chunks finish in any order; the writer drains them in input order with large
+// write(2) calls and frees each buffer once written
+class OrderedWriter {
+public:
+    OrderedWriter(std::size_t chunks, int fd) : buffers_(chunks), ready_(chunks, false), fd_(fd) {}
+
+    void complete(std::size_t index, std::string&& text) {
+        {
+            std::lock_guard<std::mutex> locker(mu_);
+            buffers_[index] = std::move(text);
+            ready_[index] = true;
+        }
+        cond_.notify_one();
+    }
+
+    void drain() {
+        for (std::size_t next = 0; next < buffers_.size(); ++next) {
+            std::string text;
+            {
+                std::unique_lock<std::mutex> locker(mu_);
+                cond_.wait(locker, [this, next]() { return static_cast<bool>(ready_[next]); });
+                text.swap(buffers_[next]);
+            }
+            write_all(text.data(), text.size());
+        }
+    }
+
+private:
+    void write_all(const char* data, std::size_t size) {
+        while (size > 0) {
+            ssize_t n = write(fd_, data, size);
+            if (n <= 0) {
+                std::perror("write");
+                return;
+            }
+            data += n;
+            size -= static_cast<std::size_t>(n);
+        }
+    }
+
+    std::mutex mu_;
+    std::condition_variable cond_;
+    std::vector<std::string> buffers_;
+    std::vector<bool> ready_;
+    int fd_;
+};
+
+// --- Parsing and formatting ---
+
+struct Chunk {
+    const char* begin;
+    const char* end;
+};
+
+// Newline-aligned chunks of roughly kChunkBytes
+std::vector<Chunk> split_chunks(const char* data, std::size_t size) {
+    std::vector<Chunk> chunks;
+    const char* end = data + size;
+    const char* p = data;
+    while (p < end) {
+        const char* q = p + std::min(kChunkBytes, static_cast<std::size_t>(end - p));
+        while (q < end && *q != '\n')
+            ++q;
+        chunks.push_back({p, q});
+        p = q;
+    }
+    return chunks;
+}
+
+void append_result(std::string& out, unsigned long long N) {
+    char buf[48];
+    out += "Result for ";
+    out.append(buf, std::to_chars(buf, buf + sizeof(buf), N).ptr);
+    out += ": ";
+    SumOfSquares r = sumOfSquares128(N);
+    if (r.overflow)
+        out += sumOfSquaresExact(N).toString();
+    else
+        out.append(buf, appendDecimal(buf, r.value));
+    out += '\n';
+}
+
+// Parse every whitespace-separated number in the chunk and format its result
+std::string process_chunk(const Chunk& chunk) {
+    std::string out;
+    out.reserve(static_cast<std::size_t>(chunk.end - chunk.begin) * 4);
+    const char* p = chunk.begin;
+    while (p < chunk.end) {
+        while (p < chunk.end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+            ++p;
+        if (p == chunk.end)
+            break;
+        unsigned long long N = 0;
+        auto parsed = std::from_chars(p, chunk.end, N);
+        if (parsed.ec != std::errc()) {
+            // Skip the malformed token
+            while (p < chunk.end && *p != ' ' && *p != '\n')
+                ++p;
+            continue;
+        }
+        append_result(out, N);
+        p = parsed.ptr;
+    }
+    return out;
+}
+
+// Cross-check the closed form against the O(N) polynomial path: both must agree
+// on the low 64 bits of 1^2 + ... + N^2 for every N up to limit
+int run_check(unsigned long long limit) {
+    const unsigned long long squares[3] = {0, 0, 1};
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long long N = 0; N <= limit; N += 1 + N / 64) {
+        const unsigned long long expected = static_cast<unsigned long long>(sumOfSquares128(N).value);
+        const unsigned long long actual = polynomialSum(N, squares, 2);
+        if (actual != expected) {
+            std::cerr << "Mismatch for " << N << ": polynomialSum " << actual
+                      << ", closed form " << expected << std::endl;
+            return 1;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cerr << "Check passed up to N = " << limit << ": " << elapsed.count() << " seconds" << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <filename> [threads]" << std::endl;
+        std::cerr << "       " << argv[0] << " --check [limit]" << std::endl;
+        return 1;
+    }
+    if (std::string(argv[1]) == "--check")
+        return run_check(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000000ULL);
+    unsigned threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : std::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+
+    int fd = open(argv[1], O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Unable to open file: " << argv[1] << std::endl;
+        return 1;
+    }
+    struct stat st;
+    fstat(fd, &st);
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    if (size == 0) {
+        close(fd);
+        return 0;
+    }
+    const char* data = static_cast<const char*>(mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+    if (data == MAP_FAILED) {
+        std::perror("mmap");
+        return 1;
+    }
+    madvise(const_cast<char*>(data), size, MADV_SEQUENTIAL);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Chunk> chunks = split_chunks(data, size);
+    OrderedWriter writer(chunks.size(), STDOUT_FILENO);
+    std::thread output(&OrderedWriter::drain, &writer);
+
+    WorkStealingPool pool(threads);
+    pool.run(chunks.size(), [&](std::size_t i) { writer.complete(i, process_chunk(chunks[i])); });
+    output.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cerr << "Processed " << size << " bytes in " << chunks.size() << " chunks on "
+              << threads << " threads: " << elapsed.count() << " seconds" << std::endl;
+
+    munmap(const_cast<char*>(data), size);
+    close(fd);
+    return 0;
+}
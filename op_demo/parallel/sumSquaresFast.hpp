@@ -0,0 +1,159 @@
+#ifndef SUM_SQUARES_FAST_HPP
+#define SUM_SQUARES_FAST_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// Fast paths for sumOfSquares(N) = 1^2 + 2^2 + ... + N^2.
+//
+// sumOfSquares128 evaluates the closed form N(N+1)(2N+1)/6 in O(1) with unsigned
+// __int128 and reports overflow instead of wrapping; sumOfSquaresExact is the
+// arbitrary-precision fallback for the N where even 128 bits are not enough
+// (N above ~1.0e13). sumOfSquaresBatch evaluates the 128-bit closed form over a
+// whole batch of N and flags the overflows; the caller formats those through
+// sumOfSquaresExact. polynomialSum is the vectorized O(N) path for generalized
+// sums of a polynomial with no closed form at hand.
+
+typedef unsigned __int128 uint128;
+
+struct SumOfSquares {
+    uint128 value;     // exact result, valid when !overflow
+    bool overflow;     // the result needs more than 128 bits
+};
+
+// Closed form without intermediate overflow: divide the factors by 2 and 3
+// first (one of N, N+1 is even; one of N, N+1, 2N+1 is a multiple of 3)
+inline void sumOfSquaresFactors(unsigned long long N, uint128 f[3]) {
+    f[0] = N;
+    f[1] = (uint128)N + 1;
+    f[2] = 2 * (uint128)N + 1;
+    if (f[0] % 2 == 0) f[0] /= 2; else f[1] /= 2;
+    if (f[0] % 3 == 0) f[0] /= 3; else if (f[1] % 3 == 0) f[1] /= 3; else f[2] /= 3;
+}
+
+inline SumOfSquares sumOfSquares128(unsigned long long N) {
+    uint128 f[3];
+    sumOfSquaresFactors(N, f);
+    SumOfSquares r;
+    uint128 ab;
+    r.overflow = __builtin_mul_overflow(f[0], f[1], &ab) || __builtin_mul_overflow(ab, f[2], &r.value);
+    return r;
+}
+
+// --- Arbitrary precision fallback ---
+
+// Minimal unsigned big integer: little-endian base 2^32 limbs
+class BigUint {
+public:
+    explicit BigUint(uint128 v = 0) {
+        while (v != 0) {
+            limbs_.push_back(static_cast<uint32_t>(v));
+            v >>= 32;
+        }
+    }
+
+    BigUint operator*(const BigUint& o) const {
+        BigUint r;
+        r.limbs_.assign(limbs_.size() + o.limbs_.size(), 0);
+        for (std::size_t i = 0; i < limbs_.size(); ++i) {
+            uint64_t carry = 0;
+            for (std::size_t j = 0; j < o.limbs_.size(); ++j) {
+                uint64_t cur = (uint64_t)limbs_[i] * o.limbs_[j] + r.limbs_[i + j] + carry;
+                r.limbs_[i + j] = static_cast<uint32_t>(cur);
+                carry = cur >> 32;
+            }
+            r.limbs_[i + o.limbs_.size()] = static_cast<uint32_t>(carry);
+        }
+        r.trim();
+        return r;
+    }
+
+    std::string toString() const {
+        if (limbs_.empty())
+            return "0";
+        std::vector<uint32_t> n = limbs_;
+        std::string digits;
+        while (!n.empty()) {
+            // Divide by 10^9 and emit the remainder as nine digits
+            uint64_t rem = 0;
+            for (std::size_t i = n.size(); i-- > 0;) {
+                uint64_t cur = (rem << 32) | n[i];
+                n[i] = static_cast<uint32_t>(cur / 1000000000u);
+                rem = cur % 1000000000u;
+            }
+            while (!n.empty() && n.back() == 0)
+                n.pop_back();
+            for (int d = 0; d < 9 && (rem != 0 || !n.empty()); ++d) {
+                digits.push_back(static_cast<char>('0' + rem % 10));
+                rem /= 10;
+            }
+        }
+        std::reverse(digits.begin(), digits.end());
+        return digits;
+    }
+
+private:
+    void trim() {
+        while (!limbs_.empty() && limbs_.back() == 0)
+            limbs_.pop_back();
+    }
+    std::vector<uint32_t> limbs_;
+};
+
+inline BigUint sumOfSquaresExact(unsigned long long N) {
+    uint128 f[3];
+    sumOfSquaresFactors(N, f);
+    return BigUint(f[0]) * BigUint(f[1]) * BigUint(f[2]);
+}
+
+// --- Batch evaluation ---
+
+// O(1) per element; returns the number of results that overflowed 128 bits
+inline std::size_t sumOfSquaresBatch(const unsigned long long* N, std::size_t count, SumOfSquares* out) {
+    std::size_t overflows = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = sumOfSquares128(N[i]);
+        overflows += out[i].overflow;
+    }
+    return overflows;
+}
+
+// --- Generalized polynomial sums ---
+
+// sum_{i=1..N} p(i) with p(i) = coeffs[0] + coeffs[1] i + ... + coeffs[degree] i^degree,
+// in wrapping 64-bit arithmetic (the low 64 bits of the exact sum). Horner runs
+// over kLanes independent terms at a time with the lane loop innermost, so -O3
+// vectorizes it without any pragma wherever 64-bit lanes can be multiplied
+// (AVX2 and up; sumSquaresParallel.sh builds with -march=native)
+inline unsigned long long polynomialSum(unsigned long long N, const unsigned long long* coeffs, int degree) {
+    const int kLanes = 8;
+    unsigned long long lane[kLanes] = {0};
+    unsigned long long i = 1;
+    for (; N >= kLanes && i <= N - (kLanes - 1); i += kLanes) {
+        unsigned long long x[kLanes], p[kLanes];
+        for (int l = 0; l < kLanes; ++l) {
+            x[l] = i + l;
+            p[l] = coeffs[degree];
+        }
+        for (int d = degree - 1; d >= 0; --d)
+            for (int l = 0; l < kLanes; ++l)
+                p[l] = p[l] * x[l] + coeffs[d];
+        for (int l = 0; l < kLanes; ++l)
+            lane[l] += p[l];
+    }
+    unsigned long long sum = 0;
+    for (int l = 0; l < kLanes; ++l)
+        sum += lane[l];
+    for (; i <= N; ++i) {
+        unsigned long long p = coeffs[degree];
+        for (int d = degree - 1; d >= 0; --d)
+            p = p * i + coeffs[d];
+        sum += p;
+    }
+    return sum;
+}
+
+#endif
@@ -1,13 +1,18 @@
 #!/bin/bash
 
-# Compile the C++ program with optimization flags 
-g++ -fopenmp -O3 -o sumSquaresParallel sumSquaresParallel.cpp
+# Compile the C++ program with optimization flags
+g++ -std=c++17 -O3 -march=native -pthread -o sumSquaresBatch sumSquaresBatch.cpp
+
+# Cross-check the closed form against the vectorized polynomial-sum path
+./sumSquaresBatch --check || exit 1
 
 # Measure start time
 start=$(date +%s.%N)
 
-# Execute the program with GNU Parallel
-cat data.txt | parallel -j+0 ./sumSquaresParallel {}
+# One process: mmap the input, work-stealing pool over the cores, ordered output.
+# (Previously: cat data.txt | parallel -j+0 ./sumSquaresParallel {}, one process
+# and one OpenMP team per input line.)
+./sumSquaresBatch data.txt
 
 # Measure end time
 end=$(date +%s.%N)
@@ -0,0 +1,169 @@
+#!/bin/bash
+
+# Compiler-optimization benchmark driver.
+#
+# Builds one op_demo kernel once per line of a flag matrix, runs every binary
+# several times pinned to a fixed CPU set, and prints a table with the median
+# wall time and the speedup over the first (baseline) configuration. OpenMP
+# threads are bound to cores (OMP_PROC_BIND=close, OMP_PLACES=cores) unless the
+# environment already sets those.
+#
+# Usage: compare_flags.sh [options] <source.c|source.cpp> [-- program args]
+#   -m <file>   flag matrix (default: flags.matrix next to this script)
+#   -r <runs>   timed runs per binary (default: 5)
+#   -c <cpu>    CPU list passed to taskset (default: every CPU this shell may
+#               run on, "" disables pinning; -c 0 times single-threaded code)
+#   -x <flags>  extra flags appended to every build (include paths, -l libs, ...)
+#   -t <args>   program arguments for the PGO training run (default: program args)
+#   -o <file>   also write the table as TSV to this file
+#
+# Flag matrix format, one configuration per line ('#' starts a comment):
+#   name | compiler | flags
+# compiler is gcc or clang (the C++ driver is picked from the source suffix).
+# The token @pgo in flags builds with profile-guided optimization: an
+# instrumented binary is run once with the training arguments and the profile
+# is fed back into the final build.
+
+script_dir=$(cd "$(dirname "$0")" && pwd)
+matrix="$script_dir/flags.matrix"
+runs=5
+cpu=$(taskset -pc $$ 2> /dev/null | sed 's/.*: //')
+extra_flags=""
+train_args=""
+train_set=0
+tsv_file=""
+
+while getopts "m:r:c:x:t:o:" opt; do
+    case $opt in
+        m) matrix=$OPTARG ;;
+        r) runs=$OPTARG ;;
+        c) cpu=$OPTARG ;;
+        x) extra_flags=$OPTARG ;;
+        t) train_args=$OPTARG; train_set=1 ;;
+        o) tsv_file=$OPTARG ;;
+        *) sed -n '3,25p' "$0"; exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+source_file=$1
+if [ -z "$source_file" ] || [ ! -f "$source_file" ] || [ ! -f "$matrix" ]; then
+    sed -n '3,25p' "$0"
+    exit 1
+fi
+shift
+if [ "$1" == "--" ]; then
+    shift
+fi
+program_args=("$@")
+if [ $train_set -eq 0 ]; then
+    train_args="${program_args[*]}"
+fi
+
+build_dir=$(mktemp -d "${TMPDIR:-/tmp}/compare_flags.XXXXXX")
+trap 'rm -rf "$build_dir"' EXIT
+
+pin=()
+if [ -n "$cpu" ] && command -v taskset > /dev/null; then
+    pin=(taskset -c "$cpu")
+fi
+export OMP_PROC_BIND=${OMP_PROC_BIND:-close}
+export OMP_PLACES=${OMP_PLACES:-cores}
+
+# Map the matrix compiler name to the C or C++ driver for this source
+compiler_for() {
+    case "$1:$source_file" in
+        gcc:*.c) echo gcc ;;
+        gcc:*) echo g++ ;;
+        clang:*.c) echo clang ;;
+        clang:*) echo clang++ ;;
+        *) echo "$1" ;;
+    esac
+}
+
+# Build one configuration; PGO configurations are built twice around a training run
+build() {
+    local compiler=$1 flags=$2 output=$3
+    local profile_dir="$output.profile"
+
+    if [[ " $flags " != *" @pgo "* ]]; then
+        $compiler $flags "$source_file" -o "$output" $extra_flags
+        return
+    fi
+
+    flags=${flags//@pgo/}
+    mkdir -p "$profile_dir"
+    if [[ $compiler == clang* ]]; then
+        $compiler $flags -fprofile-instr-generate="$profile_dir/%p.profraw" "$source_file" -o "$output" $extra_flags || return 1
+        "${pin[@]}" "$output" $train_args < /dev/null > /dev/null || return 1
+        llvm-profdata merge -o "$profile_dir/default.profdata" "$profile_dir"/*.profraw || return 1
+        $compiler $flags -fprofile-instr-use="$profile_dir/default.profdata" "$source_file" -o "$output" $extra_flags
+    else
+        $compiler $flags -fprofile-generate="$profile_dir" "$source_file" -o "$output" $extra_flags || return 1
+        "${pin[@]}" "$output" $train_args < /dev/null > /dev/null || return 1
+        $compiler $flags -fprofile-use="$profile_dir" -fprofile-correction "$source_file" -o "$output" $extra_flags
+    fi
+}
+
+# Median and minimum wall time over $runs runs
+time_binary() {
+    local binary=$1
+    local times=()
+    for ((r = 0; r < runs; r++)); do
+        local start=$EPOCHREALTIME
+        # stdin is the matrix file inside the read loop below; keep it away from the program
+        "${pin[@]}" "$binary" "${program_args[@]}" < /dev/null > /dev/null || return 1
+        local end=$EPOCHREALTIME
+        times+=("$(awk -v s="$start" -v e="$end" 'BEGIN { printf "%.6f", e - s }')")
+    done
+    printf "%s\n" "${times[@]}" | sort -g | awk '
+        { t[NR] = $1 }
+        END { m = (NR % 2) ? t[(NR + 1) / 2] : (t[NR / 2] + t[NR / 2 + 1]) / 2; printf "%.6f %.6f", m, t[1] }'
+}
+
+echo "Source: $source_file   Runs: $runs   CPU: ${cpu:-unpinned}   Args: ${program_args[*]}"
+printf "  %-24s %-8s %12s %12s %9s\n" "Configuration" "Compiler" "Median [s]" "Min [s]" "Speedup"
+printf "  %-24s %-8s %12s %12s %9s\n" "------------------------" "--------" "------------" "------------" "---------"
+if [ -n "$tsv_file" ]; then
+    printf "name\tcompiler\tflags\tmedian_s\tmin_s\tspeedup\n" > "$tsv_file"
+fi
+
+baseline=""
+index=0
+while IFS='|' read -r name compiler flags; do
+    name=$(echo "$name" | xargs)
+    compiler=$(echo "$compiler" | xargs)
+    flags=$(echo "$flags" | xargs)
+    if [ -z "$name" ] || [[ $name == \#* ]]; then
+        continue
+    fi
+
+    driver=$(compiler_for "$compiler")
+    if ! command -v "$driver" > /dev/null; then
+        printf "  %-24s %-8s %12s\n" "$name" "$compiler" "(not installed)"
+        continue
+    fi
+
+    index=$((index + 1))
+    binary="$build_dir/config_$index"
+    if ! build "$driver" "$flags" "$binary" > "$binary.log" 2>&1; then
+        printf "  %-24s %-8s %12s\n" "$name" "$compiler" "(build failed, see below)"
+        sed 's/^/      /' "$binary.log" | head -5
+        continue
+    fi
+
+    if ! result=$(time_binary "$binary"); then
+        printf "  %-24s %-8s %12s\n" "$name" "$compiler" "(run failed)"
+        continue
+    fi
+    read -r median minimum <<< "$result"
+    if [ -z "$baseline" ]; then
+        baseline=$median
+    fi
+    speedup=$(awk -v b="$baseline" -v t="$median" 'BEGIN { printf "%.2f", b / t }')
+
+    printf "  %-24s %-8s %12s %12s %8sx\n" "$name" "$compiler" "$median" "$minimum" "$speedup"
+    if [ -n "$tsv_file" ]; then
+        printf "%s\t%s\t%s\t%s\t%s\t%s\n" "$name" "$compiler" "$flags" "$median" "$minimum" "$speedup" >> "$tsv_file"
+    fi
+done < "$matrix"
@@ -0,0 +1,106 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include "dot_kernels.hpp"
+
+// Benchmark of the dot-product and AXPY kernels of every ISA this CPU supports,
+// reported as effective GB/s next to the measured memory bandwidth of the machine.
+
+double* aligned_array(std::size_t size) {
+    double* p = nullptr;
+    if (posix_memalign(reinterpret_cast<void**>(&p), 64, size * sizeof(double)) != 0) {
+        std::cerr << "Unable to allocate " << size << " doubles" << std::endl;
+        std::exit(1);
+    }
+    return p;
+}
+
+// Best-of-reps wall time of f()
+template <typename F>
+double best_time(int reps, F f) {
+    double best = -1.0;
+    for (int r = 0; r < reps; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed = end - start;
+        if (best < 0.0 || elapsed.count() < best)
+            best = elapsed.count();
+    }
+    return best;
+}
+
+// STREAM-style triad a = b + s * c: 24 bytes of traffic per element
+double measure_bandwidth(double* a, const double* b, const double* c, std::size_t size, int reps) {
+    double t = best_time(reps, [&]() {
+        for (std::size_t i = 0; i < size; ++i)
+            a[i] = b[i] + 3.0 * c[i];
+    });
+    return 24.0 * size / t / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t arraySize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000; // 10^7
+    const int reps = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    double* a = aligned_array(arraySize);
+    double* b = aligned_array(arraySize);
+    double* y = aligned_array(arraySize);
+    std::srand(1325);
+    for (std::size_t i = 0; i < arraySize; ++i) {
+        a[i] = static_cast<double>(std::rand()) / RAND_MAX;
+        b[i] = static_cast<double>(std::rand()) / RAND_MAX;
+        y[i] = 0.0;
+    }
+
+    const double bandwidth = measure_bandwidth(y, a, b, arraySize, reps);
+    const DotIsa best = detect_dot_isa();
+    std::cout << "Array size: " << arraySize << " doubles (" << arraySize * sizeof(double) / 1e6 << " MB each)" << std::endl;
+    std::cout << "Detected ISA: " << dot_kernels(best).name << std::endl;
+    std::cout << "Measured memory bandwidth (triad): " << std::fixed << std::setprecision(2) << bandwidth << " GB/s" << std::endl;
+    std::cout << std::endl;
+
+    // Scalar reference in long double for the accuracy column
+    long double reference = 0.0L;
+    for (std::size_t i = 0; i < arraySize; ++i)
+        reference += static_cast<long double>(a[i]) * b[i];
+
+    std::cout << "  ISA        Kernel   Time [s]      GB/s    % of BW   Rel error" << std::endl;
+    std::cout << "  ---------  ------  ----------  --------  ---------  ----------" << std::endl;
+
+    const DotIsa isas[] = {DotIsa::Scalar, DotIsa::SSE2, DotIsa::AVX2, DotIsa::AVX512};
+    for (DotIsa isa : isas) {
+        if (isa > best)
+            break;
+        DotKernels k = dot_kernels(isa);
+
+        double result = 0.0;
+        double t_dot = best_time(reps, [&]() { result = k.dot(a, b, arraySize); });
+        double gbs_dot = 16.0 * arraySize / t_dot / 1e9;
+        double rel_err = std::fabs((double)((result - reference) / reference));
+
+        // y += alpha * x reads x and y and writes y
+        double t_axpy = best_time(reps, [&]() { k.axpy(1e-9, a, y, arraySize); });
+        double gbs_axpy = 24.0 * arraySize / t_axpy / 1e9;
+
+        std::cout << "  " << std::left << std::setw(9) << k.name << std::right
+                  << "  dot   " << std::setw(11) << std::setprecision(6) << t_dot
+                  << std::setw(10) << std::setprecision(2) << gbs_dot
+                  << std::setw(10) << 100.0 * gbs_dot / bandwidth << "%"
+                  << std::setw(12) << std::scientific << std::setprecision(2) << rel_err
+                  << std::fixed << std::endl;
+        std::cout << "  " << std::setw(9) << ""
+                  << "  axpy  " << std::setw(11) << std::setprecision(6) << t_axpy
+                  << std::setw(10) << std::setprecision(2) << gbs_axpy
+                  << std::setw(10) << 100.0 * gbs_axpy / bandwidth << "%" << std::endl;
+    }
+
+    free(a);
+    free(b);
+    free(y);
+    return 0;
+}
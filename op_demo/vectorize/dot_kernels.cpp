@@ -0,0 +1,180 @@
+#include "dot_kernels.hpp"
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+// --- Scalar ---
+
+static double dot_scalar(const double* a, const double* b, std::size_t size) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < size; ++i)
+        s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+static void axpy_scalar(double alpha, const double* x, double* y, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i)
+        y[i] += alpha * x[i];
+}
+
+// --- SSE2: 2 doubles per register, no FMA ---
+
+__attribute__((target("sse2")))
+static double dot_sse2(const double* a, const double* b, std::size_t size) {
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+    __m128d acc2 = _mm_setzero_pd(), acc3 = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+        acc2 = _mm_add_pd(acc2, _mm_mul_pd(_mm_loadu_pd(a + i + 4), _mm_loadu_pd(b + i + 4)));
+        acc3 = _mm_add_pd(acc3, _mm_mul_pd(_mm_loadu_pd(a + i + 6), _mm_loadu_pd(b + i + 6)));
+    }
+    __m128d acc = _mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3));
+    double result = _mm_cvtsd_f64(_mm_add_sd(acc, _mm_unpackhi_pd(acc, acc)));
+    for (; i < size; ++i)
+        result += a[i] * b[i];
+    return result;
+}
+
+__attribute__((target("sse2")))
+static void axpy_sse2(double alpha, const double* x, double* y, std::size_t size) {
+    const __m128d va = _mm_set1_pd(alpha);
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(va, _mm_loadu_pd(x + i))));
+        _mm_storeu_pd(y + i + 2, _mm_add_pd(_mm_loadu_pd(y + i + 2), _mm_mul_pd(va, _mm_loadu_pd(x + i + 2))));
+    }
+    for (; i < size; ++i)
+        y[i] += alpha * x[i];
+}
+
+// --- AVX2 + FMA: 4 doubles per register ---
+
+__attribute__((target("avx2,fma")))
+static double dot_avx2(const double* a, const double* b, std::size_t size) {
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), acc1);
+        acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), acc2);
+        acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), acc3);
+    }
+    __m256d acc = _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3));
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    double result = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    for (; i < size; ++i)
+        result += a[i] * b[i];
+    return result;
+}
+
+__attribute__((target("avx2,fma")))
+static void axpy_avx2(double alpha, const double* x, double* y, std::size_t size) {
+    const __m256d va = _mm256_set1_pd(alpha);
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+        _mm256_storeu_pd(y + i + 4, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)));
+    }
+    for (; i < size; ++i)
+        y[i] += alpha * x[i];
+}
+
+// --- AVX-512F: 8 doubles per register, masked tail ---
+
+__attribute__((target("avx512f")))
+static double dot_avx512(const double* a, const double* b, std::size_t size) {
+    __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+    __m512d acc2 = _mm512_setzero_pd(), acc3 = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), acc0);
+        acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8), acc1);
+        acc2 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 16), _mm512_loadu_pd(b + i + 16), acc2);
+        acc3 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 24), _mm512_loadu_pd(b + i + 24), acc3);
+    }
+    for (; i + 8 <= size; i += 8)
+        acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), acc0);
+    if (i < size) {
+        const __mmask8 tail = static_cast<__mmask8>((1u << (size - i)) - 1);
+        acc1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, a + i), _mm512_maskz_loadu_pd(tail, b + i), acc1);
+    }
+    __m512d acc = _mm512_add_pd(_mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3));
+    alignas(64) double lanes[8];
+    _mm512_store_pd(lanes, acc);
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+__attribute__((target("avx512f")))
+static void axpy_avx512(double alpha, const double* x, double* y, std::size_t size) {
+    const __m512d va = _mm512_set1_pd(alpha);
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        _mm512_storeu_pd(y + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+        _mm512_storeu_pd(y + i + 8, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8)));
+    }
+    for (; i + 8 <= size; i += 8)
+        _mm512_storeu_pd(y + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+    if (i < size) {
+        const __mmask8 tail = static_cast<__mmask8>((1u << (size - i)) - 1);
+        __m512d vy = _mm512_fmadd_pd(va, _mm512_maskz_loadu_pd(tail, x + i), _mm512_maskz_loadu_pd(tail, y + i));
+        _mm512_mask_storeu_pd(y + i, tail, vy);
+    }
+}
+
+// --- Runtime dispatch ---
+
+__attribute__((target("xsave")))
+static unsigned long long read_xcr0() {
+    return _xgetbv(0);
+}
+
+DotIsa detect_dot_isa() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return DotIsa::Scalar;
+    const bool sse2 = edx & bit_SSE2;
+    const bool fma = ecx & bit_FMA;
+    const bool osxsave = ecx & bit_OSXSAVE;
+    if (!osxsave)
+        return sse2 ? DotIsa::SSE2 : DotIsa::Scalar;
+
+    // The OS must save the YMM (bits 1-2) and ZMM/opmask (bits 5-7) state
+    const unsigned long long xcr0 = read_xcr0();
+    const bool os_avx = (xcr0 & 0x6) == 0x6;
+    const bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+
+    bool avx2 = false, avx512f = false;
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        avx2 = ebx & bit_AVX2;
+        avx512f = ebx & bit_AVX512F;
+    }
+    if (avx512f && os_avx512)
+        return DotIsa::AVX512;
+    if (avx2 && fma && os_avx)
+        return DotIsa::AVX2;
+    return sse2 ? DotIsa::SSE2 : DotIsa::Scalar;
+}
+
+DotKernels dot_kernels(DotIsa isa) {
+    switch (isa) {
+    case DotIsa::AVX512: return {isa, "AVX-512", dot_avx512, axpy_avx512};
+    case DotIsa::AVX2: return {isa, "AVX2+FMA", dot_avx2, axpy_avx2};
+    case DotIsa::SSE2: return {isa, "SSE2", dot_sse2, axpy_sse2};
+    default: return {DotIsa::Scalar, "Scalar", dot_scalar, axpy_scalar};
+    }
+}
+
+const DotKernels& best_dot_kernels() {
+    static const DotKernels kernels = dot_kernels(detect_dot_isa());
+    return kernels;
+}
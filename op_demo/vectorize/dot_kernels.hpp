@@ -0,0 +1,40 @@
+#ifndef DOT_KERNELS_HPP
+#define DOT_KERNELS_HPP
+
+#include <cstddef>
+
+// Dot product and AXPY kernels with explicit SSE2, AVX2+FMA and AVX-512
+// implementations. Each keeps several independent vector accumulators so that
+// consecutive FMAs do not wait on each other's latency. The best ISA the CPU and
+// OS support is chosen at run time through CPUID.
+
+enum class DotIsa { Scalar, SSE2, AVX2, AVX512 };
+
+using DotFn = double (*)(const double* a, const double* b, std::size_t size);
+using AxpyFn = void (*)(double alpha, const double* x, double* y, std::size_t size);  // y += alpha * x
+
+struct DotKernels {
+    DotIsa isa;
+    const char* name;
+    DotFn dot;
+    AxpyFn axpy;
+};
+
+// Highest ISA usable on this machine (CPUID feature bits plus XGETBV OS state)
+DotIsa detect_dot_isa();
+
+// Kernels of one specific ISA; the caller must make sure the ISA is supported
+DotKernels dot_kernels(DotIsa isa);
+
+// Kernels for the detected ISA, resolved once
+const DotKernels& best_dot_kernels();
+
+inline double dot_product(const double* a, const double* b, std::size_t size) {
+    return best_dot_kernels().dot(a, b, size);
+}
+
+inline void axpy(double alpha, const double* x, double* y, std::size_t size) {
+    best_dot_kernels().axpy(alpha, x, y, size);
+}
+
+#endif
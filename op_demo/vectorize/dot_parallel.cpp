@@ -0,0 +1,284 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "dot_kernels.hpp"
+
+// Multithreaded, NUMA-aware dot product.
+//
+// Each thread is pinned to one CPU, maps its own chunk of a and b and
+// first-touch-initializes it, so the pages land on the thread's NUMA node and the
+// data is written exactly once. Partial sums are kept per fixed-size block and
+// reduced in block order, so the result is bit-identical for any thread count.
+
+const std::size_t kBlock = 1 << 16;   // elements per reduction block
+
+// --- Topology ---
+
+// CPUs of each NUMA node from sysfs; a single node with every allowed CPU otherwise
+std::vector<std::vector<int>> numa_nodes() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+
+    std::vector<std::vector<int>> nodes;
+    for (int node = 0;; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file.is_open())
+            break;
+        std::string list;
+        std::getline(file, list);
+        std::vector<int> cpus;
+        std::stringstream ss(list);
+        std::string range;
+        while (std::getline(ss, range, ',')) {
+            int first = 0, last = 0;
+            if (std::sscanf(range.c_str(), "%d-%d", &first, &last) == 1)
+                last = first;
+            for (int cpu = first; cpu <= last; ++cpu)
+                if (CPU_ISSET(cpu, &allowed))
+                    cpus.push_back(cpu);
+        }
+        if (!cpus.empty())
+            nodes.push_back(cpus);
+    }
+    if (nodes.empty()) {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &allowed))
+                cpus.push_back(cpu);
+        nodes.push_back(cpus);
+    }
+    return nodes;
+}
+
+// First `threads` CPUs, filling the first `node_count` nodes evenly
+std::vector<int> place_threads(const std::vector<std::vector<int>>& nodes, int threads, int node_count) {
+    std::vector<int> cpus;
+    for (int t = 0; t < threads; ++t) {
+        const std::vector<int>& node = nodes[t % node_count];
+        cpus.push_back(node[(t / node_count) % node.size()]);
+    }
+    return cpus;
+}
+
+void pin_to_cpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+// --- Helpers ---
+
+// Value of element i, independent of which thread initializes it
+inline double element_value(std::uint64_t i, std::uint64_t seed) {
+    std::uint64_t x = (i ^ seed) + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return static_cast<double>(x >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Sense-reversing spin barrier; the team meets here twice per repetition
+class SpinBarrier {
+public:
+    explicit SpinBarrier(int count) : count_(count), waiting_(0), sense_(false) {}
+    void wait() {
+        const bool sense = sense_.load(std::memory_order_relaxed);
+        if (waiting_.fetch_add(1, std::memory_order_acq_rel) + 1 == count_) {
+            waiting_.store(0, std::memory_order_relaxed);
+            sense_.store(!sense, std::memory_order_release);
+        } else {
+            while (sense_.load(std::memory_order_acquire) == sense)
+                std::this_thread::yield();
+        }
+    }
+private:
+    const int count_;
+    std::atomic<int> waiting_;
+    std::atomic<bool> sense_;
+};
+
+struct Chunk {
+    double* a = nullptr;
+    double* b = nullptr;
+    std::size_t begin_block = 0, end_block = 0;   // [begin, end) reduction blocks
+    std::size_t bytes = 0;
+};
+
+// Reserve virtual memory only; the pages are placed by whoever touches them first
+double* map_doubles(std::size_t count, std::size_t& bytes) {
+    bytes = (count * sizeof(double) + 4095) / 4096 * 4096;
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        std::cerr << "mmap of " << bytes << " bytes failed" << std::endl;
+        std::exit(1);
+    }
+    return static_cast<double*>(p);
+}
+
+struct RunResult {
+    double seconds;   // best of the repetitions
+    double result;
+};
+
+// Run one configuration. With first_touch the threads map and initialize their own
+// chunks; otherwise the main thread initializes the whole arrays serially (every
+// page on its node) and the threads only compute, as vectorize.cpp does today.
+RunResult run_parallel_dot(const std::vector<int>& cpus, std::size_t size, int reps, bool first_touch) {
+    const int threads = static_cast<int>(cpus.size());
+    const std::size_t blocks = (size + kBlock - 1) / kBlock;
+    const std::uint64_t seed_a = 1325, seed_b = 1326;
+
+    std::vector<Chunk> chunks(threads);
+    for (int t = 0; t < threads; ++t) {
+        chunks[t].begin_block = blocks * t / threads;
+        chunks[t].end_block = blocks * (t + 1) / threads;
+    }
+
+    // Shared arrays for the serial-initialization mode
+    double* shared_a = nullptr;
+    double* shared_b = nullptr;
+    std::size_t shared_bytes = 0;
+    if (!first_touch) {
+        shared_a = map_doubles(size, shared_bytes);
+        shared_b = map_doubles(size, shared_bytes);
+        for (std::size_t i = 0; i < size; ++i) {
+            shared_a[i] = element_value(i, seed_a);
+            shared_b[i] = element_value(i, seed_b);
+        }
+    }
+
+    std::vector<double> block_sums(blocks, 0.0);
+    std::vector<double> seconds(threads, 0.0);   // each worker's time for its range, per rep
+    SpinBarrier barrier(threads + 1);
+    const DotFn dot = best_dot_kernels().dot;
+
+    auto worker = [&](int t) {
+        pin_to_cpu(cpus[t]);
+        Chunk& c = chunks[t];
+        const std::size_t first = c.begin_block * kBlock;
+        const std::size_t last = std::min(c.end_block * kBlock, size);
+        if (first_touch) {
+            c.a = map_doubles(last - first, c.bytes);
+            c.b = map_doubles(last - first, c.bytes);
+            for (std::size_t i = first; i < last; ++i) {
+                c.a[i - first] = element_value(i, seed_a);
+                c.b[i - first] = element_value(i, seed_b);
+            }
+        } else {
+            c.a = shared_a + first;
+            c.b = shared_b + first;
+        }
+
+        for (int r = 0; r < reps; ++r) {
+            barrier.wait();   // start
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t blk = c.begin_block; blk < c.end_block; ++blk) {
+                const std::size_t lo = blk * kBlock - first;
+                const std::size_t n = std::min(kBlock, size - blk * kBlock);
+                block_sums[blk] = dot(c.a + lo, c.b + lo, n);
+            }
+            seconds[t] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            barrier.wait();   // done
+        }
+        if (first_touch) {
+            munmap(c.a, c.bytes);
+            munmap(c.b, c.bytes);
+        }
+    };
+
+    std::vector<std::thread> team;
+    for (int t = 0; t < threads; ++t)
+        team.emplace_back(worker, t);
+
+    RunResult best{-1.0, 0.0};
+    for (int r = 0; r < reps; ++r) {
+        barrier.wait();   // start
+        barrier.wait();   // done
+        // Deterministic reduction: always block order
+        auto start = std::chrono::steady_clock::now();
+        double result = 0.0;
+        for (double s : block_sums)
+            result += s;
+        std::chrono::duration<double> reduce = std::chrono::steady_clock::now() - start;
+        // The workers time their own ranges: main may be released from the start
+        // barrier after they are, so its clock would miss part of the work
+        const double elapsed = *std::max_element(seconds.begin(), seconds.end()) + reduce.count();
+        if (best.seconds < 0.0 || elapsed < best.seconds)
+            best.seconds = elapsed;
+        best.result = result;
+    }
+    for (std::thread& th : team)
+        th.join();
+
+    if (!first_touch) {
+        munmap(shared_a, shared_bytes);
+        munmap(shared_b, shared_bytes);
+    }
+    return best;
+}
+
+// Usage: dot_parallel [size] [reps]
+int main(int argc, char* argv[]) {
+    const std::size_t arraySize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000; // 10^8
+    const int reps = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    const std::vector<std::vector<int>> nodes = numa_nodes();
+    int total_cpus = 0;
+    for (const auto& node : nodes)
+        total_cpus += static_cast<int>(node.size());
+    const int per_node = static_cast<int>(nodes[0].size());
+
+    std::cout << "Array size: " << arraySize << " doubles, " << 16.0 * arraySize / 1e9 << " GB read per dot" << std::endl;
+    std::cout << "NUMA nodes: " << nodes.size() << ", CPUs: " << total_cpus
+              << ", kernel: " << best_dot_kernels().name << std::endl;
+    std::cout << std::endl;
+    std::cout << "  Threads  Nodes  Init          Time [s]      GB/s   Speedup  Result" << std::endl;
+    std::cout << "  -------  -----  -----------  ----------  --------  -------  ------------------" << std::endl;
+
+    double t1 = 0.0;
+    auto report = [&](int threads, int node_count, bool first_touch) {
+        std::vector<int> cpus = place_threads(nodes, threads, node_count);
+        RunResult r = run_parallel_dot(cpus, arraySize, reps, first_touch);
+        if (t1 == 0.0)
+            t1 = r.seconds;
+        std::cout << "  " << std::setw(7) << threads << "  " << std::setw(5) << node_count
+                  << "  " << std::left << std::setw(11) << (first_touch ? "first-touch" : "serial") << std::right
+                  << "  " << std::setw(10) << std::fixed << std::setprecision(6) << r.seconds
+                  << "  " << std::setw(8) << std::setprecision(2) << 16.0 * arraySize / r.seconds / 1e9
+                  << "  " << std::setw(6) << t1 / r.seconds << "x"
+                  << "  " << std::setprecision(10) << r.result << std::endl;
+    };
+
+    // Scaling inside one socket, then across sockets
+    for (int threads = 1; threads < per_node; threads *= 2)
+        report(threads, 1, true);
+    report(per_node, 1, true);
+    for (int node_count = 2; node_count <= static_cast<int>(nodes.size()); ++node_count) {
+        int threads = 0;
+        for (int n = 0; n < node_count; ++n)
+            threads += static_cast<int>(nodes[n].size());
+        report(threads, node_count, true);
+    }
+
+    // The same full-machine run with every page initialized serially on one node
+    report(total_cpus, static_cast<int>(nodes.size()), false);
+
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "dot_kernels.hpp"
+
+// Streaming dot product over two binary vector files (raw little-endian doubles)
+// that do not have to fit in memory. A background reader thread fills one pair of
+// buffers with pread while the main thread runs the SIMD dot product on the other,
+// so each block's I/O overlaps the previous block's compute. Stall times on both
+// sides tell whether the run is I/O-bound or compute-bound.
+
+const std::size_t kAlign = 4096;
+
+struct Buffer {
+    double* a = nullptr;
+    double* b = nullptr;
+    std::size_t count = 0;     // doubles in this block
+    bool full = false;
+    bool last = false;         // no blocks after this one
+};
+
+double* aligned_block(std::size_t bytes) {
+    void* p = nullptr;
+    if (posix_memalign(&p, kAlign, bytes) != 0) {
+        std::cerr << "Unable to allocate " << bytes << " bytes" << std::endl;
+        std::exit(1);
+    }
+    return static_cast<double*>(p);
+}
+
+// Read exactly `bytes` (or up to end of file) at `offset`
+std::size_t read_fully(int fd, void* dst, std::size_t bytes, off_t offset) {
+    std::size_t done = 0;
+    while (done < bytes) {
+        ssize_t n = pread(fd, static_cast<char*>(dst) + done, bytes - done, offset + done);
+        if (n < 0) {
+            std::perror("pread");
+            std::exit(1);
+        }
+        if (n == 0)
+            break;
+        done += static_cast<std::size_t>(n);
+    }
+    return done;
+}
+
+int open_input(const std::string& path, bool direct, off_t& size) {
+    int flags = O_RDONLY | (direct ? O_DIRECT : 0);
+    int fd = open(path.c_str(), flags);
+    if (fd < 0) {
+        std::cerr << "Unable to open file: " << path << std::endl;
+        std::exit(1);
+    }
+    struct stat st;
+    fstat(fd, &st);
+    size = st.st_size;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    return fd;
+}
+
+// Write `count` random doubles to each of two files
+int generate(const std::string& path_a, const std::string& path_b, std::size_t count) {
+    const std::size_t block = 1 << 20;
+    double* buf = aligned_block(block * sizeof(double));
+    std::srand(1325);
+    for (const std::string& path : {path_a, path_b}) {
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            std::cerr << "Unable to create file: " << path << std::endl;
+            return 1;
+        }
+        for (std::size_t done = 0; done < count; done += block) {
+            std::size_t n = std::min(block, count - done);
+            for (std::size_t i = 0; i < n; ++i)
+                buf[i] = static_cast<double>(std::rand()) / RAND_MAX;
+            if (write(fd, buf, n * sizeof(double)) != static_cast<ssize_t>(n * sizeof(double))) {
+                std::perror("write");
+                return 1;
+            }
+        }
+        close(fd);
+    }
+    free(buf);
+    std::cout << "Wrote " << count << " doubles to " << path_a << " and " << path_b << std::endl;
+    return 0;
+}
+
+int stream_dot(const std::string& path_a, const std::string& path_b, std::size_t block_bytes, bool direct) {
+    off_t size_a = 0, size_b = 0;
+    int fd_a = open_input(path_a, direct, size_a);
+    int fd_b = open_input(path_b, direct, size_b);
+    if (size_a != size_b || size_a % sizeof(double) != 0) {
+        std::cerr << "Input files must have the same size, a multiple of 8 bytes" << std::endl;
+        return 1;
+    }
+    block_bytes = (block_bytes + kAlign - 1) / kAlign * kAlign;
+
+    Buffer buffers[2];
+    for (Buffer& buf : buffers) {
+        buf.a = aligned_block(block_bytes);
+        buf.b = aligned_block(block_bytes);
+    }
+    std::mutex mu;
+    std::condition_variable cond;
+    double read_seconds = 0.0, reader_stall_seconds = 0.0;
+
+    // Reader: fill buffers in turn; waiting for a free buffer means compute is behind
+    std::thread reader([&]() {
+        off_t offset = 0;
+        int index = 0;
+        while (true) {
+            Buffer& buf = buffers[index];
+            {
+                auto start = std::chrono::steady_clock::now();
+                std::unique_lock<std::mutex> locker(mu);
+                cond.wait(locker, [&buf]() { return !buf.full; });
+                std::chrono::duration<double> waited = std::chrono::steady_clock::now() - start;
+                reader_stall_seconds += waited.count();
+            }
+            auto start = std::chrono::steady_clock::now();
+            std::size_t got = read_fully(fd_a, buf.a, block_bytes, offset);
+            read_fully(fd_b, buf.b, block_bytes, offset);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            read_seconds += elapsed.count();
+
+            offset += static_cast<off_t>(got);
+            const bool last = offset >= size_a;
+            {
+                std::lock_guard<std::mutex> locker(mu);
+                buf.count = got / sizeof(double);
+                buf.last = last;
+                buf.full = true;
+            }
+            cond.notify_all();
+            if (last)
+                break;
+            index ^= 1;
+        }
+    });
+
+    // Compute: dot product of each block as soon as it is full
+    const DotFn dot = best_dot_kernels().dot;
+    double result = 0.0, compute_seconds = 0.0, io_stall_seconds = 0.0;
+    std::size_t processed = 0;
+    auto wall_start = std::chrono::steady_clock::now();
+    int index = 0;
+    while (true) {
+        Buffer& buf = buffers[index];
+        {
+            auto start = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> locker(mu);
+            cond.wait(locker, [&buf]() { return buf.full; });
+            std::chrono::duration<double> waited = std::chrono::steady_clock::now() - start;
+            io_stall_seconds += waited.count();
+        }
+        auto start = std::chrono::steady_clock::now();
+        result += dot(buf.a, buf.b, buf.count);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        compute_seconds += elapsed.count();
+        processed += buf.count;
+
+        const bool last = buf.last;
+        {
+            std::lock_guard<std::mutex> locker(mu);
+            buf.full = false;
+        }
+        cond.notify_all();
+        if (last)
+            break;
+        index ^= 1;
+    }
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wall_start;
+    reader.join();
+
+    const double gb = 2.0 * processed * sizeof(double) / 1e9;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Elements: " << processed << " (" << gb << " GB read), block: " << block_bytes / (1024 * 1024) << " MB x 2 files x 2 buffers" << std::endl;
+    std::cout << "Kernel: " << best_dot_kernels().name << (direct ? ", O_DIRECT" : ", page cache") << std::endl;
+    std::cout << "Result: " << std::setprecision(10) << result << std::setprecision(3) << std::endl;
+    std::cout << "Wall time:           " << wall.count() << " s (" << gb / wall.count() << " GB/s)" << std::endl;
+    std::cout << "Read time:           " << read_seconds << " s (" << gb / read_seconds << " GB/s)" << std::endl;
+    std::cout << "Compute time:        " << compute_seconds << " s (" << gb / compute_seconds << " GB/s)" << std::endl;
+    std::cout << "Compute waiting I/O: " << io_stall_seconds << " s" << std::endl;
+    std::cout << "Reader waiting CPU:  " << reader_stall_seconds << " s" << std::endl;
+    std::cout << "Verdict: " << (io_stall_seconds > reader_stall_seconds ? "I/O-bound" : "compute-bound")
+              << " (compute keeps up with " << 100.0 * read_seconds / std::max(read_seconds, compute_seconds)
+              << "% of the disk rate)" << std::endl;
+
+    for (Buffer& buf : buffers) {
+        free(buf.a);
+        free(buf.b);
+    }
+    close(fd_a);
+    close(fd_b);
+    return 0;
+}
+
+// Usage:
+//   dot_stream generate <a.bin> <b.bin> <count>
+//   dot_stream <a.bin> <b.bin> [block_mb] [direct]
+int main(int argc, char* argv[]) {
+    auto usage = [&]() {
+        std::cerr << "Usage: " << argv[0] << " generate <a.bin> <b.bin> <count>" << std::endl;
+        std::cerr << "       " << argv[0] << " <a.bin> <b.bin> [block_mb] [direct]" << std::endl;
+        std::cerr << "       block_mb: whole number of MB per block, at least 1 (default 16)" << std::endl;
+        return 1;
+    };
+    if (argc >= 5 && std::string(argv[1]) == "generate")
+        return generate(argv[2], argv[3], std::strtoull(argv[4], nullptr, 10));
+    if (argc < 3)
+        return usage();
+
+    // A zero block would never advance the read offset
+    std::size_t block_mb = 16;
+    if (argc > 3) {
+        char* end = nullptr;
+        const unsigned long long mb = std::strtoull(argv[3], &end, 10);
+        const std::size_t max_mb = SIZE_MAX / (1024 * 1024);
+        if (argv[3][0] < '0' || argv[3][0] > '9' || *end != '\0' || mb < 1 || mb > max_mb)
+            return usage();
+        block_mb = static_cast<std::size_t>(mb);
+    }
+    const bool direct = argc > 4 && std::string(argv[4]) == "direct";
+    return stream_dot(argv[1], argv[2], block_mb * 1024 * 1024, direct);
+}
@@ -1 +1,16 @@
-g++ -o vectorize vectorize.cpp
+# -O3 and -fopenmp-simd are needed for the `#pragma omp simd` loop to be honoured
+g++ -O3 -fopenmp-simd -o vectorize vectorize.cpp
+
+# Multi-ISA dot/AXPY kernel library (runtime CPUID dispatch) and its benchmark
+g++ -O3 -o dot_bench dot_bench.cpp dot_kernels.cpp
+./dot_bench
+
+# Multithreaded NUMA-aware dot product (pinned threads, first-touch chunks)
+g++ -O3 -pthread -o dot_parallel dot_parallel.cpp dot_kernels.cpp
+./dot_parallel
+
+# Streaming dot product over files larger than RAM (pread on a background thread,
+# double-buffered); generate test vectors first, then stream them
+g++ -O3 -pthread -o dot_stream dot_stream.cpp dot_kernels.cpp
+./dot_stream generate a.bin b.bin 100000000
+./dot_stream a.bin b.bin 16
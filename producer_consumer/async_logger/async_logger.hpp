@@ -0,0 +1,367 @@
+#ifndef ASYNC_LOGGER_HPP
+#define ASYNC_LOGGER_HPP
+
+#include <atomic>
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include "cache_line.hpp"
+#include "tsc_clock.hpp"
+#include "spsc_ring_buffer.hpp"
+
+// Asynchronous binary logger.
+//
+// A logging thread does not format anything: log() stamps the TSC and copies the
+// format string's address and the raw arguments into a 64-byte LogRecord in
+// that thread's own SPSC ring (registered on its first call). One background
+// thread drains every ring, orders each batch by timestamp, substitutes the
+// arguments for the "{}" placeholders and writes the text with one write(2) per
+// buffer. Logging threads never take a lock, make a syscall or wait on each
+// other; when a thread's ring is full the record is dropped and counted, and
+// the count is reported in the output.
+//
+// Each thread keeps its rings in a thread_local list keyed by logger, so one
+// thread may log to several loggers. A thread's ring is shared between it and
+// the logger: when the thread exits the writer drains the ring and retires it,
+// and when the logger is destroyed the thread drops its entry on its next
+// registration.
+//
+// Format strings and const char* arguments are stored by address, so they must
+// outlive the logger: string literals, or strings owned by objects that do.
+// Up to kMaxArgs arguments of integer, floating-point, bool, char or const char*
+// type.
+
+class AsyncLogger {
+public:
+    static const size_t kMaxArgs = 5;
+    static const size_t kRingCapacity = 1024;               // records per thread
+    static const size_t kWriteBuffer = 64 * 1024;
+
+    // Writes to `fd` (not closed by the logger)
+    explicit AsyncLogger(int fd) : fd_(fd), owns_fd_(false) { start(); }
+
+    // Appends to the file at `path`
+    explicit AsyncLogger(const std::string& path)
+        : fd_(open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644)), owns_fd_(true) {
+        if (fd_ < 0)
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        start();
+    }
+
+    ~AsyncLogger() {
+        stopping_.store(true, std::memory_order_release);
+        writer_.join();
+        for (const std::shared_ptr<ThreadBuffer>& t : threads_)
+            t->logger_gone.store(true, std::memory_order_relaxed);
+        if (owns_fd_)
+            close(fd_);
+    }
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    // Records one line; "{}" in `format` is replaced by the next argument
+    template <typename... Args>
+    void log(const char* format, Args... args) {
+        static_assert(sizeof...(Args) <= kMaxArgs, "too many log arguments");
+        ThreadBuffer* buffer = thread_buffer();
+        RecordRing::Span span = buffer->ring.claim(1);
+        if (span.size() == 0) {
+            buffer->dropped.store(buffer->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        LogRecord* record = span.first;
+        record->timestamp = TscClock::now();
+        record->format = format;
+        record->count = static_cast<uint8_t>(sizeof...(Args));
+        encode(record, 0, args...);
+        buffer->ring.commit(1);
+    }
+
+    // Records dropped so far because a thread's ring was full
+    uint64_t dropped() const {
+        std::lock_guard<std::mutex> locker(threads_mu_);
+        uint64_t total = retired_dropped_;
+        for (const std::shared_ptr<ThreadBuffer>& t : threads_)
+            total += t->dropped.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    enum ArgType : uint8_t { kInt, kUint, kDouble, kBool, kChar, kString };
+
+    struct alignas(kCacheLineSize) LogRecord {
+        const char* format;
+        uint64_t timestamp;
+        uint8_t count;
+        uint8_t types[kMaxArgs];
+        uint64_t args[kMaxArgs];
+    };
+    static_assert(sizeof(LogRecord) == kCacheLineSize, "a record should fill one cache line");
+
+    using RecordRing = LockFreeSPSCRingBuffer<LogRecord, kRingCapacity, BusySpinWait>;
+
+    struct ThreadBuffer {
+        explicit ThreadBuffer(unsigned i) : index(i) {}
+        RecordRing ring;
+        std::atomic<uint64_t> dropped{0};   // written by the owner only
+        uint64_t reported_dropped = 0;      // writer thread only
+        const unsigned index;
+        std::atomic<bool> owner_exited{false};   // set after the owner's last record
+        std::atomic<bool> logger_gone{false};    // set once the writer has stopped
+    };
+
+    // The calling thread's rings, one per logger it has logged to
+    struct ThreadCache {
+        uint64_t last_id = 0;
+        ThreadBuffer* last = nullptr;
+        std::vector<std::pair<uint64_t, std::shared_ptr<ThreadBuffer>>> entries;
+
+        ~ThreadCache() {
+            for (const auto& entry : entries)
+                entry.second->owner_exited.store(true, std::memory_order_release);
+        }
+    };
+
+    // --- Argument encoding (hot path) ---
+
+    static void encode(LogRecord*, size_t) {}
+
+    template <typename Arg, typename... Rest>
+    static void encode(LogRecord* record, size_t i, Arg arg, Rest... rest) {
+        store(record, i, arg);
+        encode(record, i + 1, rest...);
+    }
+
+    template <typename Arg>
+    static void store(LogRecord* record, size_t i, Arg arg) {
+        if constexpr (std::is_same<Arg, bool>::value) {
+            record->types[i] = kBool;
+            record->args[i] = arg;
+        } else if constexpr (std::is_same<Arg, char>::value) {
+            record->types[i] = kChar;
+            record->args[i] = static_cast<unsigned char>(arg);
+        } else if constexpr (std::is_integral<Arg>::value && std::is_signed<Arg>::value) {
+            record->types[i] = kInt;
+            record->args[i] = static_cast<uint64_t>(static_cast<int64_t>(arg));
+        } else if constexpr (std::is_integral<Arg>::value || std::is_enum<Arg>::value) {
+            record->types[i] = kUint;
+            record->args[i] = static_cast<uint64_t>(arg);
+        } else if constexpr (std::is_floating_point<Arg>::value) {
+            const double d = arg;
+            record->types[i] = kDouble;
+            std::memcpy(&record->args[i], &d, sizeof(d));
+        } else {
+            static_assert(std::is_convertible<Arg, const char*>::value, "unsupported log argument type");
+            record->types[i] = kString;
+            record->args[i] = reinterpret_cast<uintptr_t>(static_cast<const char*>(arg));
+        }
+    }
+
+    // This thread's ring, registered on first use
+    ThreadBuffer* thread_buffer() {
+        static thread_local ThreadCache cache;
+        if (cache.last_id != id_)
+            switch_logger(cache);
+        return cache.last;
+    }
+
+    // Slow path: this thread last logged elsewhere, or never logged here
+    void switch_logger(ThreadCache& cache) {
+        std::vector<std::pair<uint64_t, std::shared_ptr<ThreadBuffer>>>& entries = cache.entries;
+        for (const auto& entry : entries) {
+            if (entry.first == id_) {
+                cache.last_id = id_;
+                cache.last = entry.second.get();
+                return;
+            }
+        }
+        // Forget the rings of loggers that no longer exist
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [](const auto& entry) {
+            return entry.second->logger_gone.load(std::memory_order_relaxed);
+        }), entries.end());
+
+        std::shared_ptr<ThreadBuffer> buffer;
+        {
+            std::lock_guard<std::mutex> locker(threads_mu_);
+            buffer = std::make_shared<ThreadBuffer>(next_index_++);
+            threads_.push_back(buffer);
+        }
+        entries.emplace_back(id_, buffer);
+        cache.last_id = id_;
+        cache.last = buffer.get();
+    }
+
+    // --- Background writer ---
+
+    void start() {
+        static std::atomic<uint64_t> next_id{1};
+        id_ = next_id.fetch_add(1, std::memory_order_relaxed);
+        TscClock::calibrate(20);
+        start_tsc_ = TscClock::now();
+        out_.reserve(kWriteBuffer + 1024);
+        writer_ = std::thread(&AsyncLogger::writer_loop, this);
+    }
+
+    struct Pending {
+        LogRecord record;
+        unsigned thread;
+    };
+
+    void writer_loop() {
+        std::vector<Pending> batch;
+        while (true) {
+            // Read the flag first, so the last drain sees everything logged before it
+            const bool stopping = stopping_.load(std::memory_order_acquire);
+            batch.clear();
+            {
+                std::lock_guard<std::mutex> locker(threads_mu_);
+                for (size_t i = 0; i < threads_.size();) {
+                    // Checked before the drain: the owner's last record precedes the flag
+                    const bool exited = threads_[i]->owner_exited.load(std::memory_order_acquire);
+                    drain(*threads_[i], batch);
+                    if (exited) {
+                        retired_dropped_ += threads_[i]->dropped.load(std::memory_order_relaxed);
+                        threads_[i] = std::move(threads_.back());
+                        threads_.pop_back();
+                    } else {
+                        ++i;
+                    }
+                }
+            }
+            std::stable_sort(batch.begin(), batch.end(), [](const Pending& a, const Pending& b) {
+                return a.record.timestamp < b.record.timestamp;
+            });
+            for (const Pending& p : batch) {
+                format(p);
+                if (out_.size() >= kWriteBuffer)
+                    flush();
+            }
+            flush();
+            if (stopping)
+                return;
+            if (batch.empty())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    void drain(ThreadBuffer& t, std::vector<Pending>& batch) {
+        RecordRing::Span span = t.ring.peek(kRingCapacity);
+        for (size_t i = 0; i < span.first_len; ++i)
+            batch.push_back(Pending{span.first[i], t.index});
+        for (size_t i = 0; i < span.second_len; ++i)
+            batch.push_back(Pending{span.second[i], t.index});
+        t.ring.consume(span.size());
+
+        const uint64_t dropped = t.dropped.load(std::memory_order_relaxed);
+        if (dropped != t.reported_dropped) {
+            out_ += "[logger] thread ";
+            append(static_cast<uint64_t>(t.index));
+            out_ += " dropped ";
+            append(dropped - t.reported_dropped);
+            out_ += " records (ring full)\n";
+            t.reported_dropped = dropped;
+        }
+    }
+
+    // "<seconds since start> T<thread> <formatted text>\n"
+    void format(const Pending& p) {
+        const LogRecord& r = p.record;
+        const uint64_t ns = TscClock::to_ns(r.timestamp > start_tsc_ ? r.timestamp - start_tsc_ : 0);
+        append(ns / 1000000000);
+        out_ += '.';
+        char frac[16];
+        const std::to_chars_result res = std::to_chars(frac, frac + sizeof(frac), 1000000000 + ns % 1000000000);
+        out_.append(frac + 1, res.ptr);   // nine digits, zero-padded
+        out_ += " T";
+        append(static_cast<uint64_t>(p.thread));
+        out_ += ' ';
+
+        size_t arg = 0;
+        for (const char* f = r.format; *f; ++f) {
+            if (f[0] == '{' && f[1] == '}' && arg < r.count) {
+                append_arg(r.types[arg], r.args[arg]);
+                ++arg;
+                ++f;
+            } else {
+                out_ += *f;
+            }
+        }
+        out_ += '\n';
+    }
+
+    void append_arg(uint8_t type, uint64_t value) {
+        switch (type) {
+        case kInt:
+            append(static_cast<int64_t>(value));
+            break;
+        case kUint:
+            append(value);
+            break;
+        case kDouble: {
+            double d;
+            std::memcpy(&d, &value, sizeof(d));
+            append(d);
+            break;
+        }
+        case kBool:
+            out_ += value ? "true" : "false";
+            break;
+        case kChar:
+            out_ += static_cast<char>(value);
+            break;
+        case kString: {
+            const char* s = reinterpret_cast<const char*>(static_cast<uintptr_t>(value));
+            out_ += s ? s : "(null)";
+            break;
+        }
+        }
+    }
+
+    template <typename Number>
+    void append(Number value) {
+        char digits[32];
+        const std::to_chars_result res = std::to_chars(digits, digits + sizeof(digits), value);
+        out_.append(digits, res.ptr);
+    }
+
+    void flush() {
+        size_t written = 0;
+        while (written < out_.size()) {
+            const ssize_t n = write(fd_, out_.data() + written, out_.size() - written);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                break;   // nowhere to report it; drop the rest of the buffer
+            written += static_cast<size_t>(n);
+        }
+        out_.clear();
+    }
+
+    int fd_;
+    bool owns_fd_;
+    uint64_t id_ = 0;
+    uint64_t start_tsc_ = 0;
+
+    mutable std::mutex threads_mu_;   // registration (once per thread and logger) and the writer's drain
+    std::vector<std::shared_ptr<ThreadBuffer>> threads_;   // live threads' rings
+    unsigned next_index_ = 0;
+    uint64_t retired_dropped_ = 0;   // drops of threads that have exited
+
+    std::string out_;   // writer thread only
+    std::atomic<bool> stopping_{false};
+    std::thread writer_;
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include "async_logger.hpp"
+
+// Per-call cost of a log line from `threads` threads at once: the console-mutex
+// pattern the demos used (lock, format with iostreams, std::endl) against
+// AsyncLogger. Output goes to /dev/null, so only the logging itself is measured.
+// Each thread logs in bursts of kBurst lines and then sleeps briefly, the way
+// the demos interleave work and logging; a burst fits in a logger ring, so
+// nothing is dropped.
+
+const int kBurst = 256;
+const int kBursts = 200;
+
+// One name per thread, created before the logger so it outlives the logger's
+// last drain (the records hold name.c_str())
+std::vector<std::string> thread_names(int threads) {
+    std::vector<std::string> names;
+    for (int t = 0; t < threads; ++t)
+        names.push_back("producer" + std::to_string(t + 1));
+    return names;
+}
+
+// Mean nanoseconds per log_line call
+template <typename LogFn>
+double run_threads(const std::vector<std::string>& names, LogFn log_line) {
+    const int threads = static_cast<int>(names.size());
+    std::vector<uint64_t> ticks(threads, 0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            const std::string& name = names[t];
+            for (int b = 0; b < kBursts; ++b) {
+                const uint64_t start = TscClock::now();
+                for (int i = 0; i < kBurst; ++i)
+                    log_line(name, i, b);
+                ticks[t] += TscClock::now() - start;
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        });
+    }
+    for (std::thread& w : workers)
+        w.join();
+    uint64_t total = 0;
+    for (uint64_t t : ticks)
+        total += t;
+    return static_cast<double>(TscClock::to_ns(total)) / (static_cast<double>(threads) * kBurst * kBursts);
+}
+
+double mutex_iostream(int threads) {
+    const std::vector<std::string> names = thread_names(threads);
+    std::ofstream out("/dev/null");
+    std::mutex out_mu;
+    return run_threads(names, [&](const std::string& name, int num, int sleep_time) {
+        std::lock_guard<std::mutex> lock(out_mu);
+        out << "Name: " << name << "   Produced: " << num << "   Sleep time: " << sleep_time << std::endl;
+    });
+}
+
+double async_logger(int threads, uint64_t& dropped) {
+    const std::vector<std::string> names = thread_names(threads);
+    AsyncLogger logger(std::string("/dev/null"));
+    const double ns = run_threads(names, [&](const std::string& name, int num, int sleep_time) {
+        logger.log("Name: {}   Produced: {}   Sleep time: {}", name.c_str(), num, sleep_time);
+    });
+    dropped = logger.dropped();
+    return ns;
+}
+
+int main() {
+    TscClock::calibrate();
+    std::cout << "Log call cost, " << kBursts << " bursts of " << kBurst << " lines per thread\n";
+    std::cout << "threads   mutex+iostream ns/call   AsyncLogger ns/call   dropped\n";
+    for (int threads : {1, 2, 4}) {
+        uint64_t dropped = 0;
+        const double locked = mutex_iostream(threads);
+        const double async = async_logger(threads, dropped);
+        std::cout << "   " << threads << "    " << locked << "    " << async
+                  << "    " << dropped << "\n";
+    }
+
+    // The text the writer produces, for a few lines of every argument type
+    std::cout << "\nSample output (seconds since start, thread, text):" << std::endl;
+    {
+        const std::string name = "consumer1";   // must outlive the logger
+        AsyncLogger logger(STDOUT_FILENO);
+        logger.log("Name: {}   Consumed: {}   Sleep time: {}ms", name.c_str(), 42, 17);
+        logger.log("int {} unsigned {} double {} bool {} char {}", -7, 7u, 0.25, true, 'x');
+        logger.log("no arguments");
+    }
+
+    std::cout << "\nAsync Logger Test Complete." << std::endl;
+    return 0;
+}
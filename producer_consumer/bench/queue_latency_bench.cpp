@@ -0,0 +1,300 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <cstdlib>
+#include <pthread.h>
+#include <sched.h>
+#include "cache_line.hpp"
+#include "wait_strategy.hpp"
+#include "latency_histogram.hpp"
+#include "tsc_clock.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "spsc_queue.hpp"
+#include "mpmc_queue.hpp"
+
+// One-way latency and throughput of every producer_consumer queue.
+//
+// The producer stamps each item with the TSC, the consumer subtracts the stamp
+// from its own TSC read on arrival and records the difference in a log-linear
+// histogram. Each queue runs at each offered load (items/s, 0 = as fast as
+// possible) for each thread placement the machine has:
+//
+//   same_core     both threads on one CPU
+//   smt           the two hyperthreads of one core
+//   cross_core    two cores of the same socket
+//   cross_socket  one core on each of two sockets
+//
+// Paced runs stamp the intended send time rather than the actual one, so a
+// producer that falls behind its schedule shows up as latency instead of being
+// hidden (no coordinated omission). Output is CSV on stdout, with '#' comment
+// lines describing the run, so results from two builds can be diffed or joined.
+
+struct Stamp {
+    uint64_t tsc;
+    uint64_t seq;
+};
+
+// --- Queue adapters: blocking push/pop over every queue type ---
+
+// The original lock_version design, kept as the baseline (FIFO here, so the
+// latencies are comparable)
+class MutexQueue {
+public:
+    void push(const Stamp& s) {
+        std::unique_lock<std::mutex> locker(mu_);
+        cond_.wait(locker, [this]() { return buffer_.size() < 1024; });
+        buffer_.push_back(s);
+        locker.unlock();
+        cond_.notify_all();
+    }
+    Stamp pop() {
+        std::unique_lock<std::mutex> locker(mu_);
+        cond_.wait(locker, [this]() { return !buffer_.empty(); });
+        Stamp s = buffer_.front();
+        buffer_.pop_front();
+        locker.unlock();
+        cond_.notify_all();
+        return s;
+    }
+private:
+    std::mutex mu_;
+    std::condition_variable cond_;
+    std::deque<Stamp> buffer_;
+};
+
+template <typename Queue>
+void push(Queue& q, const Stamp& s) { q.push(s); }
+template <typename Queue>
+Stamp pop(Queue& q) { return q.pop(); }
+
+template <size_t N, typename W>
+void push(LockFreeSPSCQueue<Stamp, N, W>& q, const Stamp& s) { q.add(s); }
+template <size_t N, typename W>
+Stamp pop(LockFreeSPSCQueue<Stamp, N, W>& q) { return q.remove(); }
+
+// --- Topology ---
+
+struct Placement {
+    std::string name;
+    int producer_cpu;
+    int consumer_cpu;
+};
+
+int read_topology(int cpu, const char* field) {
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + field);
+    int value = -1;
+    file >> value;
+    return value;
+}
+
+// One CPU pair per placement kind the machine offers, from the allowed CPUs
+std::vector<Placement> discover_placements() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+    struct Cpu { int id, core, package; };
+    std::vector<Cpu> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &allowed))
+            cpus.push_back({cpu, read_topology(cpu, "core_id"), read_topology(cpu, "physical_package_id")});
+
+    std::vector<Placement> placements;
+    const Cpu& first = cpus.front();
+    placements.push_back({"same_core", first.id, first.id});
+    auto find = [&](std::function<bool(const Cpu&)> match, const char* name) {
+        for (const Cpu& c : cpus) {
+            if (c.id != first.id && match(c)) {
+                placements.push_back({name, first.id, c.id});
+                return;
+            }
+        }
+    };
+    find([&](const Cpu& c) { return c.package == first.package && c.core == first.core; }, "smt");
+    find([&](const Cpu& c) { return c.package == first.package && c.core != first.core; }, "cross_core");
+    find([&](const Cpu& c) { return c.package != first.package; }, "cross_socket");
+    return placements;
+}
+
+void pin_to_cpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+// --- One run ---
+
+struct RunResult {
+    LatencyHistogram latency;     // nanoseconds
+    double throughput_mops = 0.0;
+    uint64_t out_of_order = 0;
+};
+
+template <typename Queue>
+RunResult run(const Placement& placement, double rate, uint64_t items) {
+    std::unique_ptr<Queue> queue(new Queue);
+    RunResult result;
+    std::atomic<bool> consumer_ready{false};
+    uint64_t start_tsc = 0, end_tsc = 0;
+
+    std::thread consumer([&]() {
+        pin_to_cpu(placement.consumer_cpu);
+        consumer_ready.store(true, std::memory_order_release);
+        for (uint64_t i = 0; i < items; ++i) {
+            const Stamp s = pop(*queue);
+            const uint64_t now = TscClock::now();
+            result.latency.record(TscClock::to_ns(now > s.tsc ? now - s.tsc : 0));
+            result.out_of_order += s.seq != i;
+        }
+        end_tsc = TscClock::now();
+    });
+
+    pin_to_cpu(placement.producer_cpu);
+    while (!consumer_ready.load(std::memory_order_acquire))
+        std::this_thread::yield();
+    const uint64_t interval = rate > 0 ? TscClock::from_ns(1e9 / rate) : 0;
+    start_tsc = TscClock::now();
+    uint64_t next = start_tsc;
+    for (uint64_t i = 0; i < items; ++i) {
+        if (interval) {
+            while (TscClock::now() < next)
+                cpu_relax();
+            push(*queue, Stamp{next, i});
+            next += interval;
+        } else {
+            push(*queue, Stamp{TscClock::now(), i});
+        }
+    }
+    consumer.join();
+    result.throughput_mops = items * 1e3 / TscClock::to_ns(end_tsc - start_tsc);
+    return result;
+}
+
+// --- Driver ---
+
+struct Variant {
+    std::string name;
+    std::function<RunResult(const Placement&, double, uint64_t)> run;
+};
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> parts;
+    std::stringstream ss(list);
+    std::string part;
+    while (std::getline(ss, part, ','))
+        if (!part.empty())
+            parts.push_back(part);
+    return parts;
+}
+
+bool selected(const std::vector<std::string>& filter, const std::string& name) {
+    return filter.empty() || std::find(filter.begin(), filter.end(), name) != filter.end();
+}
+
+// Usage: queue_latency_bench [--items N] [--rates r1,r2,...] [--queues q1,...]
+//                            [--placements p1,...] [--cpus P,C] [--table]
+int main(int argc, char* argv[]) {
+    uint64_t items = 1000000;
+    std::vector<double> rates = {0, 1e5, 1e6};
+    std::vector<std::string> queue_filter, placement_filter;
+    std::vector<Placement> placements = discover_placements();
+    bool table = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--items" && has_value) {
+            items = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--rates" && has_value) {
+            rates.clear();
+            for (const std::string& r : split(argv[++i]))
+                rates.push_back(std::strtod(r.c_str(), nullptr));
+        } else if (arg == "--queues" && has_value) {
+            queue_filter = split(argv[++i]);
+        } else if (arg == "--placements" && has_value) {
+            placement_filter = split(argv[++i]);
+        } else if (arg == "--cpus" && has_value) {
+            std::vector<std::string> pair = split(argv[++i]);
+            if (pair.size() == 2)
+                placements = {{"custom", std::atoi(pair[0].c_str()), std::atoi(pair[1].c_str())}};
+        } else if (arg == "--table") {
+            table = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--items N] [--rates r1,r2,...] [--queues q1,...]"
+                      << " [--placements p1,...] [--cpus P,C] [--table]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::vector<Variant> variants = {
+        {"spsc_ring", run<LockFreeSPSCRingBuffer<Stamp, 1024, BusySpinWait>>},
+        {"spsc_ring_park", run<LockFreeSPSCRingBuffer<Stamp, 1024, ParkingWait>>},
+        {"spsc_queue", run<LockFreeSPSCQueue<Stamp, 1024, BusySpinWait>>},
+        {"mpmc", run<MPMCQueue<Stamp, 1024, BusySpinWait>>},
+        {"mpmc_park", run<MPMCQueue<Stamp, 1024, ParkingWait>>},
+        {"mutex", run<MutexQueue>},
+    };
+
+    const double ticks_per_ns = TscClock::calibrate();
+    std::cout << "# queue_latency_bench items=" << items << " ticks_per_ns=" << ticks_per_ns
+              << " compiler=\"" << __VERSION__ << "\"" << std::endl;
+    for (const Placement& p : placements)
+        std::cout << "# placement " << p.name << " producer_cpu=" << p.producer_cpu << " consumer_cpu=" << p.consumer_cpu << std::endl;
+
+    const char* header[] = {"queue", "placement", "producer_cpu", "consumer_cpu", "offered_rate", "items",
+                            "throughput_mops", "mean_ns", "p50_ns", "p99_ns", "p999_ns", "max_ns", "out_of_order"};
+    for (size_t h = 0; h < sizeof(header) / sizeof(header[0]); ++h) {
+        if (table)
+            std::cout << std::setw(h < 2 ? 15 : 16) << header[h];
+        else
+            std::cout << (h ? "," : "") << header[h];
+    }
+    std::cout << std::endl;
+
+    for (const Variant& v : variants) {
+        if (!selected(queue_filter, v.name))
+            continue;
+        for (const Placement& p : placements) {
+            if (!selected(placement_filter, p.name))
+                continue;
+            for (double rate : rates) {
+                // Paced runs last about a second at most
+                const uint64_t n = rate > 0 ? std::min<uint64_t>(items, static_cast<uint64_t>(rate)) : items;
+                std::cerr << "running " << v.name << " " << p.name << " rate=" << rate << std::endl;
+                RunResult r = v.run(p, rate, n);
+                std::ostringstream fields[13];
+                fields[0] << v.name;
+                fields[1] << p.name;
+                fields[2] << p.producer_cpu;
+                fields[3] << p.consumer_cpu;
+                fields[4] << static_cast<uint64_t>(rate);
+                fields[5] << n;
+                fields[6] << std::fixed << std::setprecision(3) << r.throughput_mops;
+                fields[7] << std::fixed << std::setprecision(1) << r.latency.mean();
+                fields[8] << r.latency.percentile(50.0);
+                fields[9] << r.latency.percentile(99.0);
+                fields[10] << r.latency.percentile(99.9);
+                fields[11] << r.latency.max();
+                fields[12] << r.out_of_order;
+                for (int f = 0; f < 13; ++f) {
+                    if (table)
+                        std::cout << std::setw(f < 2 ? 15 : 16) << fields[f].str();
+                    else
+                        std::cout << (f ? "," : "") << fields[f].str();
+                }
+                std::cout << std::endl;
+            }
+        }
+    }
+    return 0;
+}
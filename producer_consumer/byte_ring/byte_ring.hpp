@@ -0,0 +1,187 @@
+#ifndef BYTE_RING_HPP
+#define BYTE_RING_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include "cache_line.hpp"
+#include "wait_strategy.hpp"
+
+// Single-producer/single-consumer ring of variable-length byte records.
+//
+// Records are stored back to back in one power-of-two byte array: an 8-byte
+// RecordHeader (payload size, flags) followed by the payload, padded to
+// kRecordAlign. A record is always contiguous; when the next one does not fit
+// before the end of the array, the producer fills the rest with a padding
+// record that the consumer skips, and starts again at offset 0. head_ and
+// tail_ are free-running byte counters with cached opposite copies, as in
+// LockFreeSPSCRingBuffer, so a message costs one counter store on each side
+// and no allocation.
+//
+// Producer: reserve(n) returns n writable bytes in the ring (serialize straight
+// into them), commit(m) publishes the first m <= n of them. write() copies.
+// Consumer: try_read() returns a Span over the oldest record, pointing into the
+// ring; it stays valid until release() hands the bytes back to the producer.
+//
+// A record's payload is at most kMaxPayload bytes (half the ring, less the
+// header), which guarantees it fits once the ring drains, padding included.
+template <size_t Capacity, typename Wait = SpinYieldWait>
+class ByteRing {
+public:
+    static_assert(Capacity >= 64, "Capacity must hold at least a few records");
+    static constexpr size_t kCapacity = round_up_pow2(Capacity);
+    static constexpr size_t kMask = kCapacity - 1;
+    static constexpr size_t kRecordAlign = 8;
+
+    struct RecordHeader {
+        uint32_t size;    // payload bytes
+        uint32_t flags;
+    };
+    static constexpr uint32_t kPadding = 1;
+    static constexpr size_t kMaxPayload = kCapacity / 2 - sizeof(RecordHeader);
+
+    // A record handed to the consumer, read in place
+    struct Span {
+        const char* data = nullptr;
+        size_t size = 0;
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+private:
+    // --- Producer line ---
+    alignas(kFalseSharingRange) std::atomic<size_t> head_{0}; // Producer's counter (bytes written)
+    size_t cached_tail_ = 0;                                   // Producer's last view of tail_
+    size_t reserved_ = 0;                                      // Where the reserved record starts
+
+    // --- Consumer line ---
+    alignas(kFalseSharingRange) std::atomic<size_t> tail_{0}; // Consumer's counter (bytes released)
+    size_t cached_head_ = 0;                                   // Consumer's last view of head_
+    size_t reading_ = 0;                                       // Where the record being read starts
+
+    // --- Shared, read-only after construction ---
+    alignas(kFalseSharingRange) char* bytes_;
+
+    // Where the producer waits for space and the consumer waits for data
+    alignas(kFalseSharingRange) Wait not_full_;
+    alignas(kFalseSharingRange) Wait not_empty_;
+
+public:
+    ByteRing()
+        : bytes_(static_cast<char*>(::operator new(kCapacity, std::align_val_t(kCacheLineSize)))) {}
+
+    ~ByteRing() { ::operator delete(bytes_, std::align_val_t(kCacheLineSize)); }
+
+    ByteRing(const ByteRing&) = delete;
+    ByteRing& operator=(const ByteRing&) = delete;
+
+    // Bytes a record with `payload` bytes occupies in the ring
+    static constexpr size_t record_size(size_t payload) {
+        return (sizeof(RecordHeader) + payload + kRecordAlign - 1) & ~(kRecordAlign - 1);
+    }
+
+    // Producer method: Reserves `size` contiguous payload bytes
+    // Returns where to write them, or nullptr if the ring is too full right now
+    // (or size exceeds kMaxPayload); nothing is visible until commit()
+    char* reserve(size_t size) {
+        if (size > kMaxPayload)
+            return nullptr;
+
+        // 1. Load the current counter and see how much is left before the end
+        size_t head = head_.load(std::memory_order_relaxed);
+        const size_t total = record_size(size);
+        const size_t to_end = kCapacity - (head & kMask);
+        const size_t needed = to_end < total ? to_end + total : total;
+
+        // 2. Check for room against the cached tail first
+        if (head + needed - cached_tail_ > kCapacity) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head + needed - cached_tail_ > kCapacity)
+                return nullptr;
+        }
+
+        // 3. Pad out the end of the array if the record would straddle it; the
+        //    padding is published together with the record
+        if (to_end < total) {
+            header_at(head)->size = static_cast<uint32_t>(to_end - sizeof(RecordHeader));
+            header_at(head)->flags = kPadding;
+            head += to_end;
+        }
+        reserved_ = head;
+        return bytes_ + (head & kMask) + sizeof(RecordHeader);
+    }
+
+    // Producer method: Publishes the first `size` bytes of the last reservation
+    void commit(size_t size) {
+        header_at(reserved_)->size = static_cast<uint32_t>(size);
+        header_at(reserved_)->flags = 0;
+        head_.store(reserved_ + record_size(size), std::memory_order_release);
+        not_empty_.notify();
+    }
+
+    // Producer method: Copies one record into the ring
+    // Returns true on success, false if there is no room right now
+    bool try_write(const void* data, size_t size) {
+        char* dst = reserve(size);
+        if (!dst)
+            return false;
+        std::memcpy(dst, data, size);
+        commit(size);
+        return true;
+    }
+
+    // Blocking variant: waits for room (size must not exceed kMaxPayload)
+    void write(const void* data, size_t size) {
+        not_full_.wait_until([&]() { return try_write(data, size); });
+    }
+
+    // Consumer method: Returns the oldest record, or an empty Span if there is none
+    // The bytes stay valid (and the slot stays taken) until release()
+    Span try_read() {
+        // 1. Load the current counter
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            // 2. Check for EMPTY against the cached head first
+            if (tail == cached_head_) {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (tail == cached_head_)
+                    return Span();
+            }
+
+            // 3. Skip a padding record, giving its bytes back straight away
+            const RecordHeader* header = header_at(tail);
+            if (header->flags & kPadding) {
+                tail += record_size(header->size);
+                tail_.store(tail, std::memory_order_release);
+                continue;
+            }
+            reading_ = tail;
+            return Span{reinterpret_cast<const char*>(header + 1), header->size};
+        }
+    }
+
+    // Blocking variant: waits for a record
+    Span read() {
+        Span span;
+        not_empty_.wait_until([&]() { return static_cast<bool>(span = try_read()); });
+        return span;
+    }
+
+    // Consumer method: Frees the record returned by the last read
+    void release(const Span& span) {
+        tail_.store(reading_ + record_size(span.size), std::memory_order_release);
+        not_full_.notify();
+    }
+
+    // Bytes in use, headers and padding included
+    size_t used() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    RecordHeader* header_at(size_t position) const {
+        return reinterpret_cast<RecordHeader*>(bytes_ + (position & kMask));
+    }
+};
+
+#endif
@@ -0,0 +1,141 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include "byte_ring.hpp"
+#include "spsc_ring_buffer.hpp"
+
+const size_t kMaxMessage = 4096;
+
+using Ring = ByteRing<256 * 1024>;
+
+// Message sizes between 16 bytes and 4 KB, mostly small, as on the order path
+std::vector<uint32_t> make_sizes(int count) {
+    std::vector<uint32_t> sizes(count);
+    uint64_t state = 42;
+    for (int i = 0; i < count; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        const uint32_t r = static_cast<uint32_t>(state >> 33);
+        sizes[i] = r % 4 ? 16 + r % 241 : 16 + r % (kMaxMessage - 15);
+    }
+    return sizes;
+}
+
+// Serializes message `seq` into `out`: its sequence number, then a byte pattern
+void fill_message(char* out, uint64_t seq, uint32_t size) {
+    std::memcpy(out, &seq, sizeof(seq));
+    for (uint32_t i = sizeof(seq); i < size; ++i)
+        out[i] = static_cast<char>(seq + i);
+}
+
+// Checks a message in place; returns false if it is not message `seq`
+bool check_message(const char* data, uint64_t seq, uint32_t size) {
+    uint64_t got;
+    std::memcpy(&got, data, sizeof(got));
+    return got == seq && data[size - 1] == static_cast<char>(seq + size - 1);
+}
+
+// --- Variable-length records ---
+
+// Producer serializes in place through reserve/commit; consumer reads in place
+void byte_ring_test(const std::vector<uint32_t>& sizes, uint64_t& errors) {
+    std::unique_ptr<Ring> ring(new Ring);
+    std::thread producer([&]() {
+        for (size_t seq = 0; seq < sizes.size(); ++seq) {
+            char* out;
+            while (!(out = ring->reserve(sizes[seq])))
+                std::this_thread::yield();
+            fill_message(out, seq, sizes[seq]);
+            ring->commit(sizes[seq]);
+        }
+    });
+    for (size_t seq = 0; seq < sizes.size(); ++seq) {
+        const Ring::Span span = ring->read();
+        errors += span.size != sizes[seq] || !check_message(span.data, seq, sizes[seq]);
+        ring->release(span);
+    }
+    producer.join();
+}
+
+// --- Baseline 1: every message padded to the maximum size ---
+
+struct PaddedMessage {
+    uint32_t size;
+    char data[kMaxMessage];
+};
+
+void padded_test(const std::vector<uint32_t>& sizes, uint64_t& errors) {
+    // Same 256 KB of ring as the byte ring (rounded up to 64 slots)
+    std::unique_ptr<LockFreeSPSCRingBuffer<PaddedMessage, 63>> ring(new LockFreeSPSCRingBuffer<PaddedMessage, 63>);
+    std::thread producer([&]() {
+        PaddedMessage m;
+        for (size_t seq = 0; seq < sizes.size(); ++seq) {
+            m.size = sizes[seq];
+            fill_message(m.data, seq, m.size);
+            ring->push(m);
+        }
+    });
+    PaddedMessage m;
+    for (size_t seq = 0; seq < sizes.size(); ++seq) {
+        while (!ring->try_pop(m))
+            std::this_thread::yield();
+        errors += m.size != sizes[seq] || !check_message(m.data, seq, m.size);
+    }
+    producer.join();
+}
+
+// --- Baseline 2: pointers to one heap allocation per message ---
+
+void heap_test(const std::vector<uint32_t>& sizes, uint64_t& errors) {
+    LockFreeSPSCRingBuffer<std::unique_ptr<std::vector<char>>, 1024> ring;
+    std::thread producer([&]() {
+        for (size_t seq = 0; seq < sizes.size(); ++seq) {
+            std::unique_ptr<std::vector<char>> m(new std::vector<char>(sizes[seq]));
+            fill_message(m->data(), seq, sizes[seq]);
+            ring.push(std::move(m));
+        }
+    });
+    for (size_t seq = 0; seq < sizes.size(); ++seq) {
+        std::unique_ptr<std::vector<char>> m = ring.pop();
+        errors += m->size() != sizes[seq] || !check_message(m->data(), seq, sizes[seq]);
+    }
+    producer.join();
+}
+
+// Function to time one transport over the same message sizes
+void run_test(const char* name, const std::vector<uint32_t>& sizes, size_t ring_bytes_per_message,
+              void (*test)(const std::vector<uint32_t>&, uint64_t&)) {
+    uint64_t payload = 0, errors = 0;
+    for (uint32_t s : sizes)
+        payload += s;
+    auto start = std::chrono::steady_clock::now();
+    test(sizes, errors);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << sizes.size() << " messages in " << elapsed.count() << " s ("
+              << sizes.size() / elapsed.count() / 1e6 << " M msgs/s, " << payload / elapsed.count() / 1e9
+              << " GB/s payload), " << ring_bytes_per_message << " ring bytes per message" << std::endl;
+    if (errors)
+        std::cerr << "ERROR: " << errors << " messages arrived corrupted or out of order" << std::endl;
+}
+
+int main() {
+    const int MESSAGE_COUNT = 500000;
+    const std::vector<uint32_t> sizes = make_sizes(MESSAGE_COUNT);
+
+    uint64_t record_bytes = 0, payload = 0;
+    for (uint32_t s : sizes) {
+        record_bytes += Ring::record_size(s);
+        payload += s;
+    }
+    std::cout << "Mean message " << payload / MESSAGE_COUNT << " bytes, max " << kMaxMessage << " bytes." << std::endl;
+
+    run_test("Byte ring (reserve/commit, read in place)", sizes, record_bytes / MESSAGE_COUNT, byte_ring_test);
+    run_test("Padded to 4 KB slots", sizes, sizeof(PaddedMessage), padded_test);
+    run_test("Heap allocation per message", sizes, sizeof(std::unique_ptr<std::vector<char>>), heap_test);
+
+    std::cout << "\nVariable-Length Byte Ring Test Complete." << std::endl;
+    return 0;
+}
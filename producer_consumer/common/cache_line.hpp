@@ -0,0 +1,36 @@
+#ifndef PRODUCER_CONSUMER_CACHE_LINE_HPP
+#define PRODUCER_CONSUMER_CACHE_LINE_HPP
+
+#include <cstddef>
+
+// Cache line geometry and sizing helpers shared by the queue implementations.
+//
+// kCacheLineSize is the coherence unit on x86-64 and most ARM cores. Data written
+// by different threads is kept kFalseSharingRange apart instead: Intel's spatial
+// prefetcher pulls lines in adjacent pairs, so two hot variables only 64 bytes
+// apart can still ping-pong between cores. (std::hardware_destructive_interference_size
+// would be the portable spelling, but GCC warns that its value is ABI-unstable.)
+
+constexpr std::size_t kCacheLineSize = 64;
+constexpr std::size_t kFalseSharingRange = 128;
+
+// Pause hint for spin-wait loops: frees pipeline resources for the sibling
+// hyperthread and avoids the memory-order violation flush on loop exit
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+// Smallest power of two >= n; ring capacities are rounded with this so slots can
+// be indexed with a mask instead of a modulus
+constexpr std::size_t round_up_pow2(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef PRODUCER_CONSUMER_LATENCY_HISTOGRAM_HPP
+#define PRODUCER_CONSUMER_LATENCY_HISTOGRAM_HPP
+
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+// Log-linear latency histogram in the style of HdrHistogram.
+//
+// Values below kSubBuckets are counted exactly; above that, every power-of-two
+// range is split into kSubBuckets equal buckets, so any recorded value is
+// reported within a relative error of 1/kSubBuckets (< 0.8%) over the whole
+// 64-bit range. Recording is an index computation and an increment, cheap
+// enough for the consumer's hot loop. Percentiles report the highest value
+// that falls in the percentile's bucket.
+class LatencyHistogram {
+public:
+    static const int kSubBucketBits = 7;
+    static const uint64_t kSubBuckets = uint64_t(1) << kSubBucketBits;
+
+    LatencyHistogram() : counts_((64 - kSubBucketBits + 1) * kSubBuckets, 0) {}
+
+    void record(uint64_t value) {
+        ++counts_[index_of(value)];
+        ++count_;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < counts_.size(); ++i)
+            counts_[i] += other.counts_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    void reset() {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        count_ = 0;
+        sum_ = 0;
+        min_ = UINT64_MAX;
+        max_ = 0;
+    }
+
+    // Value at percentile p (0..100)
+    uint64_t percentile(double p) const {
+        if (count_ == 0)
+            return 0;
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(p / 100.0 * count_ + 0.5));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= rank)
+                return std::min(highest_in_bucket(i), max_);
+        }
+        return max_;
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+private:
+    static size_t index_of(uint64_t value) {
+        if (value < kSubBuckets)
+            return static_cast<size_t>(value);
+        const int msb = 63 - __builtin_clzll(value);
+        const int shift = msb - kSubBucketBits;
+        return static_cast<size_t>((shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets));
+    }
+
+    static uint64_t highest_in_bucket(size_t index) {
+        const uint64_t magnitude = index / kSubBuckets;
+        const uint64_t sub = index % kSubBuckets;
+        if (magnitude == 0)
+            return sub;
+        const int shift = static_cast<int>(magnitude - 1);
+        return ((sub + kSubBuckets) << shift) + ((uint64_t(1) << shift) - 1);
+    }
+
+    std::vector<uint64_t> counts_;
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef PRODUCER_CONSUMER_QUEUE_STATS_HPP
+#define PRODUCER_CONSUMER_QUEUE_STATS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include "cache_line.hpp"
+
+// Runtime telemetry for the queues.
+//
+// A queue takes a Stats policy next to its Wait policy and reports every event
+// to it: items enqueued/dequeued (with the depth the producer saw, for the
+// high-water mark), operations that found the queue full/empty (stalls), and
+// the time blocking push/pop spent waiting.
+//
+//   NoQueueStats  the default; every hook is an empty inline function, so the
+//                 telemetry compiles away.
+//   QueueStats    counters in per-thread shards, one kFalseSharingRange line
+//                 each. Up to kShards - 1 live threads own a shard slot
+//                 outright and update it with plain load/store (no lock
+//                 prefix); a thread returns its slot when it exits, so pools
+//                 that come and go keep getting private shards. Threads beyond
+//                 that share the last shard through fetch_add (and a CAS for
+//                 the high-water mark). snapshot() sums the shards with
+//                 relaxed loads, so a monitoring thread can sample it at any
+//                 time; the only cost to the hot path is the owner re-fetching
+//                 its line after a sample.
+//
+// Wait times use steady_clock and are only measured once an operation has
+// already had to block.
+
+struct QueueStatsSnapshot {
+    uint64_t enqueued = 0;
+    uint64_t dequeued = 0;
+    uint64_t full_stalls = 0;     // pushes that found the queue full
+    uint64_t empty_stalls = 0;    // pops that found the queue empty
+    uint64_t full_wait_ns = 0;    // time blocking pushes spent waiting
+    uint64_t empty_wait_ns = 0;   // time blocking pops spent waiting
+    uint64_t high_water = 0;      // deepest the queue was seen by a producer
+
+    // Items in the queue when the snapshot was taken (approximate while running)
+    uint64_t depth() const { return enqueued > dequeued ? enqueued - dequeued : 0; }
+
+    // Counts since `earlier` (high_water stays the all-time maximum)
+    QueueStatsSnapshot since(const QueueStatsSnapshot& earlier) const {
+        QueueStatsSnapshot d = *this;
+        d.enqueued -= earlier.enqueued;
+        d.dequeued -= earlier.dequeued;
+        d.full_stalls -= earlier.full_stalls;
+        d.empty_stalls -= earlier.empty_stalls;
+        d.full_wait_ns -= earlier.full_wait_ns;
+        d.empty_wait_ns -= earlier.empty_wait_ns;
+        return d;
+    }
+};
+
+struct NoQueueStats {
+    void on_enqueue(size_t, size_t) {}
+    void on_dequeue(size_t) {}
+    void on_full() {}
+    void on_empty() {}
+    uint64_t wait_begin() { return 0; }
+    void on_full_wait(uint64_t) {}
+    void on_empty_wait(uint64_t) {}
+
+    // Whether the queue should spend anything (e.g. a depth load) on the hooks
+    static constexpr bool kEnabled = false;
+};
+
+class QueueStats {
+public:
+    static constexpr size_t kShards = 16;
+    static constexpr bool kEnabled = true;
+
+    // `count` items went in and the producer saw `depth` items in the queue
+    void on_enqueue(size_t count, size_t depth) {
+        Shard& s = shard();
+        add(s.enqueued, count);
+        uint64_t high = s.high_water.load(std::memory_order_relaxed);
+        if (depth <= high)
+            return;
+        if (thread_slot() != kSharedShard)
+            s.high_water.store(depth, std::memory_order_relaxed);
+        else
+            while (depth > high && !s.high_water.compare_exchange_weak(high, depth, std::memory_order_relaxed)) {}
+    }
+    void on_dequeue(size_t count) { add(shard().dequeued, count); }
+    void on_full() { add(shard().full_stalls, 1); }
+    void on_empty() { add(shard().empty_stalls, 1); }
+
+    // A blocking operation found the queue full/empty (already counted through
+    // on_full/on_empty) and is about to wait; pass the result to on_*_wait after
+    uint64_t wait_begin() { return now_ns(); }
+    void on_full_wait(uint64_t begin) { add(shard().full_wait_ns, now_ns() - begin); }
+    void on_empty_wait(uint64_t begin) { add(shard().empty_wait_ns, now_ns() - begin); }
+
+    // Safe to call from any thread while the queue is in use
+    QueueStatsSnapshot snapshot() const {
+        QueueStatsSnapshot total;
+        for (const Shard& s : shards_) {
+            total.enqueued += s.enqueued.load(std::memory_order_relaxed);
+            total.dequeued += s.dequeued.load(std::memory_order_relaxed);
+            total.full_stalls += s.full_stalls.load(std::memory_order_relaxed);
+            total.empty_stalls += s.empty_stalls.load(std::memory_order_relaxed);
+            total.full_wait_ns += s.full_wait_ns.load(std::memory_order_relaxed);
+            total.empty_wait_ns += s.empty_wait_ns.load(std::memory_order_relaxed);
+            total.high_water = std::max<uint64_t>(total.high_water, s.high_water.load(std::memory_order_relaxed));
+        }
+        return total;
+    }
+
+private:
+    struct alignas(kFalseSharingRange) Shard {
+        std::atomic<uint64_t> enqueued{0};
+        std::atomic<uint64_t> dequeued{0};
+        std::atomic<uint64_t> full_stalls{0};
+        std::atomic<uint64_t> empty_stalls{0};
+        std::atomic<uint64_t> full_wait_ns{0};
+        std::atomic<uint64_t> empty_wait_ns{0};
+        std::atomic<uint64_t> high_water{0};
+    };
+
+    static constexpr size_t kSharedShard = kShards - 1;
+    static_assert(kSharedShard <= 32, "owned slots are tracked in a 32-bit mask");
+
+    // Owned slots not held by any live thread (bit i: slot i is free)
+    static std::atomic<uint32_t>& free_slots() {
+        static std::atomic<uint32_t> mask{static_cast<uint32_t>((uint64_t(1) << kSharedShard) - 1)};
+        return mask;
+    }
+
+    // Holds the thread's slot and hands it back when the thread exits. The
+    // acquire/release on the mask orders the old owner's plain stores before
+    // the next owner's.
+    struct SlotToken {
+        SlotToken() : slot(kSharedShard) {
+            std::atomic<uint32_t>& mask = free_slots();
+            uint32_t free = mask.load(std::memory_order_relaxed);
+            while (free != 0) {
+                const uint32_t lowest = free & (~free + 1);
+                if (mask.compare_exchange_weak(free, free & ~lowest, std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+                    slot = static_cast<size_t>(__builtin_ctz(lowest));
+                    break;
+                }
+            }
+        }
+        ~SlotToken() {
+            if (slot != kSharedShard)
+                free_slots().fetch_or(uint32_t(1) << slot, std::memory_order_release);
+        }
+        size_t slot;
+    };
+
+    // The thread's shard, fixed for the thread's lifetime
+    static size_t thread_slot() {
+        static thread_local const SlotToken token;
+        return token.slot;
+    }
+
+    Shard& shard() { return shards_[thread_slot()]; }
+
+    static void add(std::atomic<uint64_t>& counter, uint64_t n) {
+        if (thread_slot() != kSharedShard)
+            counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        else
+            counter.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    Shard shards_[kShards];
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef PRODUCER_CONSUMER_TSC_CLOCK_HPP
+#define PRODUCER_CONSUMER_TSC_CLOCK_HPP
+
+#include <cstdint>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Cycle-counter timestamps for one-way latency measurements.
+//
+// On x86 this is rdtsc: ~20 cycles, no syscall, and on any CPU with an
+// invariant TSC (constant_tsc + nonstop_tsc in /proc/cpuinfo) the counter runs
+// at a fixed rate and is synchronized across cores and sockets, so a stamp taken
+// on the producer's core can be subtracted on the consumer's core. Elsewhere it
+// falls back to steady_clock nanoseconds. calibrate() measures ticks per
+// nanosecond against steady_clock.
+class TscClock {
+public:
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Spins for `millis` against steady_clock and derives the tick rate
+    static double calibrate(int millis = 100) {
+        const auto wall_start = std::chrono::steady_clock::now();
+        const uint64_t tsc_start = now();
+        while (std::chrono::steady_clock::now() - wall_start < std::chrono::milliseconds(millis)) {}
+        const uint64_t tsc_end = now();
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - wall_start;
+        ticks_per_ns() = (tsc_end - tsc_start) / elapsed.count();
+        return ticks_per_ns();
+    }
+
+    static double& ticks_per_ns() {
+        static double rate = 1.0;
+        return rate;
+    }
+
+    static uint64_t to_ns(uint64_t ticks) { return static_cast<uint64_t>(ticks / ticks_per_ns()); }
+    static uint64_t from_ns(double ns) { return static_cast<uint64_t>(ns * ticks_per_ns()); }
+};
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef PRODUCER_CONSUMER_WAIT_STRATEGY_HPP
+#define PRODUCER_CONSUMER_WAIT_STRATEGY_HPP
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <thread>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "cache_line.hpp"
+
+// Wait strategies for the blocking side of the queues.
+//
+// A queue keeps one strategy object per condition it can block on (not full,
+// not empty). The waiting side calls wait_until(ready) with a predicate that
+// retries the operation's precondition; the other side calls notify() after
+// every change that could make the predicate true (notify_all() when several
+// threads can wait on the same condition and all of them may proceed).
+//
+//   BusySpinWait   spin with a pause instruction; lowest wake-up latency, burns
+//                  a core while idle. notify() is free.
+//   SpinYieldWait  bounded spin, then sched_yield in a loop; gives the core to
+//                  other runnable threads but never sleeps. notify() is free.
+//   ParkingWait    bounded spin, bounded yield, then sleep on a futex through
+//                  an eventcount; zero CPU while idle. notify() costs a fence
+//                  and a load, plus a FUTEX_WAKE only when someone is asleep.
+
+struct BusySpinWait {
+    template <typename Ready>
+    void wait_until(Ready ready) {
+        while (!ready())
+            cpu_relax();
+    }
+    void notify() {}
+    void notify_all() {}
+};
+
+struct SpinYieldWait {
+    static const int kSpins = 128;
+
+    template <typename Ready>
+    void wait_until(Ready ready) {
+        for (int spin = 0; spin < kSpins; ++spin) {
+            if (ready())
+                return;
+            cpu_relax();
+        }
+        while (!ready())
+            std::this_thread::yield();
+    }
+    void notify() {}
+    void notify_all() {}
+};
+
+// Eventcount over a futex word: lets a thread sleep until "something changed"
+// without a lost wake-up, and without a mutex on the notifying side.
+//
+// Waiter:   key = prepare_wait(); if (ready()) cancel_wait(); else wait(key);
+// Notifier: <publish the change>; notify_one() / notify_all();
+//
+// The waiter registers (seq_cst) before re-checking its condition and the
+// notifier fences (seq_cst) between publishing and reading the waiter count, so
+// either the notifier sees the waiter and bumps the epoch, or the waiter's
+// re-check sees the change. A bump between prepare_wait and the futex call
+// makes FUTEX_WAIT return at once, since the epoch no longer equals key.
+class EventCount {
+public:
+    uint32_t prepare_wait() {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_seq_cst);
+    }
+
+    void cancel_wait() {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Sleeps until the epoch moves past key (may also return spuriously)
+    void wait(uint32_t key) {
+        if (epoch_.load(std::memory_order_acquire) == key)
+            futex(FUTEX_WAIT_PRIVATE, key);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify_one() { notify(1); }
+    void notify_all() { notify(INT_MAX); }
+
+private:
+    void notify(int count) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0)
+            return;
+        epoch_.fetch_add(1, std::memory_order_release);
+        futex(FUTEX_WAKE_PRIVATE, static_cast<uint32_t>(count));
+    }
+
+    long futex(int op, uint32_t value) {
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit int");
+        return syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), op, value, nullptr, nullptr, 0);
+    }
+
+    std::atomic<uint32_t> epoch_{0};
+    std::atomic<uint32_t> waiters_{0};
+};
+
+struct ParkingWait {
+    static const int kSpins = 128;
+    static const int kYields = 16;
+
+    template <typename Ready>
+    void wait_until(Ready ready) {
+        for (int spin = 0; spin < kSpins; ++spin) {
+            if (ready())
+                return;
+            cpu_relax();
+        }
+        for (int y = 0; y < kYields; ++y) {
+            if (ready())
+                return;
+            std::this_thread::yield();
+        }
+        while (true) {
+            const uint32_t key = events_.prepare_wait();
+            if (ready()) {
+                events_.cancel_wait();
+                return;
+            }
+            events_.wait(key);
+        }
+    }
+
+    // Wakes one sleeper; every successful operation notifies, so each freed slot
+    // or new item wakes at most one thread
+    void notify() { events_.notify_one(); }
+    void notify_all() { events_.notify_all(); }
+
+private:
+    EventCount events_;
+};
+
+#endif
@@ -0,0 +1,264 @@
+#ifndef CORO_CHANNEL_HPP
+#define CORO_CHANNEL_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <optional>
+#include <utility>
+#include "cache_line.hpp"
+#include "wait_strategy.hpp"
+#include "mpmc_queue.hpp"
+#include "executor.hpp"
+
+// Bounded multi-producer/multi-consumer channel for coroutines:
+//
+//   bool ok = co_await ch.send(x);            // false if the channel was closed
+//   std::optional<T> v = co_await ch.recv();  // nullopt once closed and drained
+//
+// Items travel through a lock-free MPMCQueue ring. While the ring has room (for
+// send) or items (for recv) an operation completes in await_ready without
+// suspending, so the coroutine never leaves its worker. Otherwise the awaiter
+// parks itself in an intrusive FIFO of waiting senders or receivers, guarded by
+// a spinlock that only the slow path touches.
+//
+// The side that makes progress does the hand-off: after a pop it moves the
+// oldest waiting sender's value into the ring, after a push it pops an item for
+// the oldest waiting receiver, and then it reschedules that coroutine on the
+// Executor. Resuming is a push onto a worker's deque, with no syscall. The fast
+// path only checks for waiters. A waiter bumps its side's count before its
+// final look at the ring, and the fast path fences between its ring operation
+// and reading the count (seq_cst on both sides). So either the fast path sees
+// the waiter, or the waiter sees the change and does not suspend.
+//
+// close() fails waiting senders and wakes waiting receivers once the ring is
+// empty; items sent before close() are still delivered. Call it once every
+// sender is done: a send racing with close() may be dropped.
+template <typename T, size_t Capacity>
+class Channel {
+    struct Waiter {
+        std::coroutine_handle<> handle;
+        Waiter* next = nullptr;
+    };
+
+public:
+    class SendAwaiter : Waiter {
+    public:
+        bool await_ready() {
+            if (ch_.closed_.load(std::memory_order_acquire)) {
+                ok_ = false;
+                return true;
+            }
+            if (!ch_.ring_.try_push(std::move(value_)))
+                return false;
+            ch_.after_push();
+            return true;
+        }
+        bool await_suspend(std::coroutine_handle<> handle) {
+            this->handle = handle;
+            return ch_.park_sender(this);
+        }
+        bool await_resume() const { return ok_; }
+
+    private:
+        friend class Channel;
+        SendAwaiter(Channel& ch, T value) : ch_(ch), value_(std::move(value)) {}
+        Channel& ch_;
+        T value_;
+        bool ok_ = true;
+    };
+
+    class RecvAwaiter : Waiter {
+    public:
+        bool await_ready() {
+            if (ch_.ring_.try_pop(value_)) {
+                has_value_ = true;
+                ch_.after_pop();
+                return true;
+            }
+            return false;
+        }
+        bool await_suspend(std::coroutine_handle<> handle) {
+            this->handle = handle;
+            return ch_.park_receiver(this);
+        }
+        std::optional<T> await_resume() {
+            if (!has_value_)
+                return std::nullopt;
+            return std::optional<T>(std::move(value_));
+        }
+
+    private:
+        friend class Channel;
+        explicit RecvAwaiter(Channel& ch) : ch_(ch) {}
+        Channel& ch_;
+        T value_{};
+        bool has_value_ = false;
+    };
+
+    explicit Channel(Executor& executor) : executor_(executor) {}
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    SendAwaiter send(T value) { return SendAwaiter(*this, std::move(value)); }
+    RecvAwaiter recv() { return RecvAwaiter(*this); }
+
+    void close() {
+        lock();
+        closed_.store(true, std::memory_order_release);
+        hand_off_locked();
+        // Anyone still waiting will never be matched
+        while (SendAwaiter* s = static_cast<SendAwaiter*>(pop_front(senders_))) {
+            waiting_senders_.fetch_sub(1, std::memory_order_relaxed);
+            s->ok_ = false;
+            executor_.schedule(s->handle);
+        }
+        while (RecvAwaiter* r = static_cast<RecvAwaiter*>(pop_front(receivers_))) {
+            waiting_receivers_.fetch_sub(1, std::memory_order_relaxed);
+            executor_.schedule(r->handle);
+        }
+        unlock();
+    }
+
+private:
+    struct WaitList {
+        Waiter* head = nullptr;
+        Waiter* tail = nullptr;
+    };
+
+    // --- Fast path: a cheap check for parked coroutines ---
+
+    void after_push() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting_receivers_.load(std::memory_order_relaxed) != 0)
+            hand_off();
+    }
+
+    void after_pop() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting_senders_.load(std::memory_order_relaxed) != 0)
+            hand_off();
+    }
+
+    // --- Slow path ---
+
+    // Returns false if the send completed after all (the coroutine goes on)
+    bool park_sender(SendAwaiter* s) {
+        lock();
+        // 1. Register, then look at the ring one last time
+        waiting_senders_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);   // pairs with after_pop()
+        const bool closed = closed_.load(std::memory_order_relaxed);
+        if (closed || ring_.try_push(std::move(s->value_))) {
+            waiting_senders_.fetch_sub(1, std::memory_order_relaxed);
+            unlock();
+            if (closed)
+                s->ok_ = false;
+            else
+                after_push();
+            return false;
+        }
+        // 2. Still full: wait for a receiver to move the value in
+        push_back(senders_, s);
+        unlock();
+        return true;
+    }
+
+    // Returns false if an item (or the close) arrived after all
+    bool park_receiver(RecvAwaiter* r) {
+        lock();
+        // 1. Register, then look at the ring one last time
+        waiting_receivers_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);   // pairs with after_push()
+        if (ring_.try_pop(r->value_)) {
+            waiting_receivers_.fetch_sub(1, std::memory_order_relaxed);
+            unlock();
+            r->has_value_ = true;
+            after_pop();
+            return false;
+        }
+        if (closed_.load(std::memory_order_relaxed)) {
+            waiting_receivers_.fetch_sub(1, std::memory_order_relaxed);
+            unlock();
+            return false;
+        }
+        // 2. Still empty: wait for a sender to pop an item for us
+        push_back(receivers_, r);
+        unlock();
+        return true;
+    }
+
+    void hand_off() {
+        lock();
+        hand_off_locked();
+        unlock();
+    }
+
+    // Matches parked senders with free slots and parked receivers with items
+    // until neither side can move; each match may enable one on the other side
+    void hand_off_locked() {
+        bool progress = true;
+        while (progress) {
+            progress = false;
+            while (senders_.head) {
+                SendAwaiter* s = static_cast<SendAwaiter*>(senders_.head);
+                if (!ring_.try_push(std::move(s->value_)))
+                    break;
+                pop_front(senders_);
+                waiting_senders_.fetch_sub(1, std::memory_order_relaxed);
+                executor_.schedule(s->handle);
+                progress = true;
+            }
+            while (receivers_.head) {
+                RecvAwaiter* r = static_cast<RecvAwaiter*>(receivers_.head);
+                if (!ring_.try_pop(r->value_))
+                    break;
+                pop_front(receivers_);
+                waiting_receivers_.fetch_sub(1, std::memory_order_relaxed);
+                r->has_value_ = true;
+                executor_.schedule(r->handle);
+                progress = true;
+            }
+        }
+    }
+
+    static void push_back(WaitList& list, Waiter* w) {
+        w->next = nullptr;
+        if (list.tail)
+            list.tail->next = w;
+        else
+            list.head = w;
+        list.tail = w;
+    }
+
+    static Waiter* pop_front(WaitList& list) {
+        Waiter* w = list.head;
+        if (w) {
+            list.head = w->next;
+            if (!list.head)
+                list.tail = nullptr;
+        }
+        return w;
+    }
+
+    void lock() {
+        while (locked_.exchange(true, std::memory_order_acquire))
+            SpinYieldWait().wait_until([this]() { return !locked_.load(std::memory_order_relaxed); });
+    }
+    void unlock() { locked_.store(false, std::memory_order_release); }
+
+    MPMCQueue<T, Capacity, BusySpinWait> ring_;
+
+    // Parked coroutines; the counts are read by the fast path without the lock
+    alignas(kFalseSharingRange) std::atomic<size_t> waiting_senders_{0};
+    std::atomic<size_t> waiting_receivers_{0};
+    std::atomic<bool> closed_{false};
+
+    alignas(kFalseSharingRange) std::atomic<bool> locked_{false};
+    WaitList senders_;
+    WaitList receivers_;
+
+    Executor& executor_;
+};
+
+#endif
@@ -0,0 +1,187 @@
+#ifndef CORO_EXECUTOR_HPP
+#define CORO_EXECUTOR_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "cache_line.hpp"
+#include "wait_strategy.hpp"
+#include "mpmc_queue.hpp"
+#include "chase_lev_deque.hpp"
+
+class Executor;
+
+// Fire-and-forget coroutine. It starts suspended and only runs once handed to
+// Executor::spawn; its frame is freed when the body returns. An exception that
+// escapes the body terminates the program.
+class Task {
+public:
+    struct promise_type {
+        Executor* executor = nullptr;
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept;
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    Task(Task&& other) noexcept : handle_(other.handle_) { other.handle_ = nullptr; }
+    ~Task() {
+        if (handle_)
+            handle_.destroy();   // never spawned
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+private:
+    friend class Executor;
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// Runs coroutines on a fixed set of worker threads.
+//
+// The same structure as ThreadPool (thread_pool.hpp), with suspended coroutine
+// handles in place of tasks: every worker owns a ChaseLevDeque of handles and
+// pops it LIFO, so a coroutine woken by the one running on this worker (a
+// channel hand-off) runs next, while it is hot in cache; idle workers steal the
+// oldest handles from the others. Threads outside the pool schedule through the
+// MPMCQueue injection queue.
+//
+// Resuming a coroutine is a push onto a deque plus ParkingWait::notify(), a
+// fence and a load while every worker is busy; the futex syscall is only made
+// to wake a worker that has gone to sleep for lack of work.
+class Executor {
+public:
+    explicit Executor(unsigned threads = std::thread::hardware_concurrency()) {
+        const unsigned workers = threads > 0 ? threads : 1;
+        for (unsigned w = 0; w < workers; ++w)
+            workers_.emplace_back(new Worker(w));
+        for (unsigned w = 0; w < workers; ++w)
+            threads_.emplace_back(&Executor::worker_loop, this, w);
+    }
+
+    ~Executor() {
+        wait();
+        stopping_.store(true, std::memory_order_release);
+        idle_.notify_all();
+        for (std::thread& t : threads_)
+            t.join();
+    }
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+    // Starts `task` on one of the workers
+    void spawn(Task task) {
+        std::coroutine_handle<Task::promise_type> handle = task.handle_;
+        task.handle_ = nullptr;
+        handle.promise().executor = this;
+        live_.fetch_add(1, std::memory_order_relaxed);
+        schedule(handle);
+    }
+
+    // Queues a suspended coroutine to be resumed by a worker
+    void schedule(std::coroutine_handle<> handle) {
+        if (Worker* self = current_worker())
+            self->deque.push(handle.address());
+        else
+            injected_.push(handle.address());   // spins while the injection queue is full
+        idle_.notify();
+    }
+
+    // Returns once every spawned task has finished
+    void wait() {
+        done_.wait_until([this]() { return live_.load(std::memory_order_acquire) == 0; });
+    }
+
+private:
+    friend struct Task::promise_type;
+
+    struct alignas(kFalseSharingRange) Worker {
+        explicit Worker(unsigned index) : rng(0x9e3779b97f4a7c15ull * (index + 1)) {}
+        ChaseLevDeque<void*> deque;   // coroutine_handle<>::address()
+        uint64_t rng;                 // victim selection (xorshift)
+    };
+
+    // Which executor and worker the current thread is, if any
+    struct Context {
+        Executor* executor = nullptr;
+        Worker* worker = nullptr;
+    };
+    static Context& context() {
+        static thread_local Context ctx;
+        return ctx;
+    }
+
+    Worker* current_worker() const {
+        const Context& ctx = context();
+        return ctx.executor == this ? ctx.worker : nullptr;
+    }
+
+    void task_done() {
+        if (live_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            done_.notify_all();
+    }
+
+    // Own deque first, then the injection queue, then the other workers
+    void* find_handle(Worker* self) {
+        void* handle = nullptr;
+        if (self->deque.pop(handle))
+            return handle;
+        if (injected_.try_pop(handle))
+            return handle;
+        uint64_t r = self->rng;
+        r ^= r << 13;
+        r ^= r >> 7;
+        r ^= r << 17;
+        self->rng = r;
+        const size_t workers = workers_.size();
+        for (size_t i = 0; i < workers; ++i) {
+            Worker* victim = workers_[(r + i) % workers].get();
+            if (victim != self && victim->deque.steal(handle))
+                return handle;
+        }
+        return nullptr;
+    }
+
+    void worker_loop(unsigned index) {
+        Worker* self = workers_[index].get();
+        context() = Context{this, self};
+        while (true) {
+            void* handle = nullptr;
+            idle_.wait_until([&]() {
+                handle = find_handle(self);
+                return handle != nullptr || stopping_.load(std::memory_order_acquire);
+            });
+            if (!handle)
+                return;
+            std::coroutine_handle<>::from_address(handle).resume();
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    MPMCQueue<void*, 4096, BusySpinWait> injected_;
+    alignas(kFalseSharingRange) ParkingWait idle_;
+    alignas(kFalseSharingRange) std::atomic<size_t> live_{0};   // spawned tasks not yet finished
+    ParkingWait done_;
+    alignas(kFalseSharingRange) std::atomic<bool> stopping_{false};
+};
+
+// The body's locals are gone by now; only the frame itself is freed after this
+inline std::suspend_never Task::promise_type::final_suspend() noexcept {
+    if (executor)
+        executor->task_done();
+    return {};
+}
+
+#endif
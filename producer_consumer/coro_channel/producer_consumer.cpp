@@ -0,0 +1,172 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include "executor.hpp"
+#include "channel.hpp"
+#include "mpmc_queue.hpp"
+
+// Fan-in: many sources feeding a few sinks through one bounded channel.
+//
+// As coroutines, 10,000 sources and 4 sinks share an Executor with a handful
+// of worker threads; a source or sink that finds the channel full/empty
+// suspends and is resumed by whoever frees a slot or sends an item. The
+// baseline is the thread-per-producer design of the other demos: 1,000 OS
+// threads blocking on an MPMCQueue (10,000 would need 10,000 stacks).
+
+struct Message {
+    uint32_t source = 0;
+    uint32_t seq = 0;
+};
+
+const int kCoroSources = 10000;
+const int kCoroMessages = 100;
+const int kThreadSources = 1000;
+const int kThreadMessages = 1000;
+const int kSinks = 4;
+const int kRoundTrips = 100000;
+
+using MessageChannel = Channel<Message, 1024>;
+
+struct Totals {
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> checksum{0};
+};
+
+// Expected checksum for `sources` sources of `messages` each
+uint64_t expected_checksum(uint64_t sources, uint64_t messages) {
+    return messages * sources * (sources - 1) / 2 + sources * messages * (messages - 1) / 2;
+}
+
+void report(const char* name, const Totals& totals, uint64_t sources, uint64_t messages, double seconds) {
+    const uint64_t received = totals.received.load();
+    const bool ok = received == sources * messages && totals.checksum.load() == expected_checksum(sources, messages);
+    std::cout << name << ": " << received << " messages from " << sources << " sources in " << seconds << " s ("
+              << received / seconds / 1e6 << " M msg/s)" << (ok ? "" : "  ** MISMATCH **") << std::endl;
+}
+
+// --- Coroutines ---
+
+Task source(MessageChannel& ch, uint32_t id, std::atomic<int>& running) {
+    for (uint32_t seq = 0; seq < kCoroMessages; ++seq)
+        co_await ch.send(Message{id, seq});
+    // The last source out closes the channel, which ends the sinks
+    if (running.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        ch.close();
+}
+
+Task sink(MessageChannel& ch, Totals& totals) {
+    uint64_t received = 0;
+    uint64_t checksum = 0;
+    while (std::optional<Message> m = co_await ch.recv()) {
+        ++received;
+        checksum += m->source + m->seq;
+    }
+    totals.received += received;
+    totals.checksum += checksum;
+}
+
+void coroutine_fan_in(unsigned workers) {
+    Executor executor(workers);
+    MessageChannel ch(executor);
+    Totals totals;
+    std::atomic<int> running{kCoroSources};
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < kSinks; ++s)
+        executor.spawn(sink(ch, totals));
+    for (int id = 0; id < kCoroSources; ++id)
+        executor.spawn(source(ch, static_cast<uint32_t>(id), running));
+    executor.wait();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "(" << workers << " worker threads) ";
+    report("Coroutines", totals, kCoroSources, kCoroMessages, elapsed.count());
+}
+
+// Ping-pong through two small channels: every recv finds its channel empty, so
+// every hop suspends one coroutine and resumes the other through the Executor
+Task pinger(Channel<int, 2>& ping, Channel<int, 2>& pong, double& ns_per_trip) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRoundTrips; ++i) {
+        co_await ping.send(i);
+        co_await pong.recv();
+    }
+    ns_per_trip = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kRoundTrips;
+    ping.close();
+}
+
+Task ponger(Channel<int, 2>& ping, Channel<int, 2>& pong) {
+    while (std::optional<int> v = co_await ping.recv())
+        co_await pong.send(*v);
+}
+
+void coroutine_ping_pong(unsigned workers) {
+    Executor executor(workers);
+    Channel<int, 2> ping(executor);
+    Channel<int, 2> pong(executor);
+    double ns_per_trip = 0;
+    executor.spawn(ponger(ping, pong));
+    executor.spawn(pinger(ping, pong, ns_per_trip));
+    executor.wait();
+    std::cout << "(" << workers << " worker threads) Ping-pong: " << ns_per_trip << " ns per round trip" << std::endl;
+}
+
+// --- One OS thread per producer ---
+
+void thread_fan_in() {
+    MPMCQueue<Message, 1024> queue;
+    Totals totals;
+    const Message stop{UINT32_MAX, 0};
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> sinks;
+    for (int s = 0; s < kSinks; ++s) {
+        sinks.emplace_back([&]() {
+            uint64_t received = 0;
+            uint64_t checksum = 0;
+            while (true) {
+                const Message m = queue.pop();
+                if (m.source == stop.source)
+                    break;
+                ++received;
+                checksum += m.source + m.seq;
+            }
+            totals.received += received;
+            totals.checksum += checksum;
+        });
+    }
+    std::vector<std::thread> sources;
+    for (int id = 0; id < kThreadSources; ++id) {
+        sources.emplace_back([&, id]() {
+            for (uint32_t seq = 0; seq < kThreadMessages; ++seq)
+                queue.push(Message{static_cast<uint32_t>(id), seq});
+        });
+    }
+    for (std::thread& t : sources)
+        t.join();
+    for (int s = 0; s < kSinks; ++s)
+        queue.push(stop);
+    for (std::thread& t : sinks)
+        t.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    report("OS threads", totals, kThreadSources, kThreadMessages, elapsed.count());
+}
+
+int main() {
+    const unsigned workers = std::max(2u, std::thread::hardware_concurrency());
+
+    std::cout << "--- Fan-in ---" << std::endl;
+    coroutine_fan_in(workers);
+    thread_fan_in();
+
+    std::cout << "\n--- Suspend/resume ---" << std::endl;
+    coroutine_ping_pong(1);
+    coroutine_ping_pong(workers);
+
+    std::cout << "\nCoroutine Channel Test Complete." << std::endl;
+    return 0;
+}
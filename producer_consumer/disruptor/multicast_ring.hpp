@@ -0,0 +1,158 @@
+#ifndef MULTICAST_RING_HPP
+#define MULTICAST_RING_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "cache_line.hpp"
+#include "wait_strategy.hpp"
+
+// Single-producer multicast ring in the style of the LMAX Disruptor.
+//
+// Every message is written once into a preallocated slot and read in place by
+// every consumer. Sequences are 64-bit and never wrap: the producer's cursor_
+// is the highest published sequence, and each consumer owns a Sequence that is
+// the highest one it has finished with. A consumer may only read up to
+// min(cursor_, sequences of the consumers it depends on), so dependencies form a
+// graph (e.g. the strategy only sees a message after the risk checker has). The
+// producer may only reuse a slot once every leaf consumer (one nobody depends
+// on, hence the slowest of its chain) has moved past it.
+//
+// Slots are reused in place, so T must be default-constructible; a consumer may
+// annotate the slot for the consumers that depend on it (they read it strictly
+// after it released the sequence).
+
+// A sequence on its own line, so every consumer's progress counter is written
+// without disturbing anyone else's
+struct alignas(kFalseSharingRange) Sequence {
+    std::atomic<int64_t> value{-1};
+
+    int64_t get() const { return value.load(std::memory_order_acquire); }
+    void set(int64_t v) { value.store(v, std::memory_order_release); }
+};
+
+template <typename T, size_t Capacity, typename Wait = SpinYieldWait>
+class MulticastRing {
+public:
+    static_assert(Capacity > 0, "Capacity must be greater than 0");
+    static constexpr size_t kCapacity = round_up_pow2(Capacity);
+    static constexpr int64_t kMask = static_cast<int64_t>(kCapacity) - 1;
+
+    // A registered reader: its progress plus the sequences it is gated on
+    class Consumer {
+    public:
+        // Highest sequence this consumer has finished with
+        int64_t sequence() const { return sequence_.get(); }
+
+    private:
+        friend class MulticastRing;
+        Sequence sequence_;
+        std::vector<const Sequence*> upstream_;   // cursor or the consumers it depends on
+        bool leaf_ = true;
+    };
+
+    MulticastRing() : slots_(new T[kCapacity]) {}
+    ~MulticastRing() { delete[] slots_; }
+
+    MulticastRing(const MulticastRing&) = delete;
+    MulticastRing& operator=(const MulticastRing&) = delete;
+
+    // Registers a consumer that reads a message only after every consumer in
+    // `depends_on` is done with it (after the producer publishes it, if empty).
+    // All consumers must be registered before the producer starts.
+    Consumer& add_consumer(std::vector<Consumer*> depends_on = {}) {
+        consumers_.emplace_back();
+        Consumer& c = consumers_.back();
+        if (depends_on.empty())
+            c.upstream_.push_back(&cursor_);
+        for (Consumer* d : depends_on) {
+            c.upstream_.push_back(&d->sequence_);
+            d->leaf_ = false;
+        }
+        return c;
+    }
+
+    // --- Producer ---
+
+    // Claims the next `n` sequences and returns the highest; waits while that
+    // would overwrite a slot some consumer has not finished with
+    int64_t claim(int64_t n = 1) {
+        const int64_t next = claimed_ + n;
+        const int64_t wrap_point = next - static_cast<int64_t>(kCapacity);
+        if (wrap_point > cached_gating_) {
+            space_.wait_until([&]() {
+                cached_gating_ = slowest_leaf();
+                return wrap_point <= cached_gating_;
+            });
+        }
+        claimed_ = next;
+        return next;
+    }
+
+    // The slot for a claimed (producer) or available (consumer) sequence
+    T& operator[](int64_t seq) { return slots_[seq & kMask]; }
+
+    // Makes every claimed sequence up to `seq` visible to the consumers
+    void publish(int64_t seq) {
+        cursor_.set(seq);
+        progress_.notify_all();
+    }
+
+    // --- Consumers ---
+
+    // Waits until `seq` is readable by `c` and returns the highest readable
+    // sequence, so the consumer can process the whole batch before releasing
+    int64_t wait_for(const Consumer& c, int64_t seq) {
+        int64_t available = min_of(c.upstream_);
+        if (available < seq) {
+            progress_.wait_until([&]() {
+                available = min_of(c.upstream_);
+                return available >= seq;
+            });
+        }
+        return available;
+    }
+
+    // `c` is done with everything up to `seq`
+    void release(Consumer& c, int64_t seq) {
+        c.sequence_.set(seq);
+        // Downstream consumers wait on progress_ too; the producer on space_
+        progress_.notify_all();
+        if (c.leaf_)
+            space_.notify();
+    }
+
+    int64_t cursor() const { return cursor_.get(); }
+
+private:
+    static int64_t min_of(const std::vector<const Sequence*>& sequences) {
+        int64_t lowest = std::numeric_limits<int64_t>::max();
+        for (const Sequence* s : sequences)
+            lowest = std::min(lowest, s->get());
+        return lowest;
+    }
+
+    int64_t slowest_leaf() const {
+        int64_t lowest = cursor_.get();
+        for (const Consumer& c : consumers_)
+            if (c.leaf_)
+                lowest = std::min(lowest, c.sequence_.get());
+        return lowest;
+    }
+
+    // Producer-local state
+    alignas(kFalseSharingRange) int64_t claimed_ = -1;
+    int64_t cached_gating_ = -1;
+
+    Sequence cursor_;
+    T* const slots_;
+    std::deque<Consumer> consumers_;    // stable addresses
+
+    alignas(kFalseSharingRange) Wait progress_;   // consumers wait for cursor/upstream
+    alignas(kFalseSharingRange) Wait space_;      // producer waits for the slowest leaf
+};
+
+#endif
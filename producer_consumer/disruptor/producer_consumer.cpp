@@ -0,0 +1,153 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include "multicast_ring.hpp"
+#include "spsc_ring_buffer.hpp"
+
+// An order as it leaves the gateway; the risk checker fills in `approved`
+struct Order {
+    uint64_t id;
+    uint64_t timestamp;
+    double price;
+    int64_t quantity;
+    char symbol[16];
+    bool approved;
+};
+
+// Stand-ins for the three pipeline stages
+bool risk_check(const Order& o) { return o.quantity <= 900; }
+
+uint64_t journal(uint64_t checksum, const Order& o) {
+    return checksum * 31 + o.id + static_cast<uint64_t>(o.quantity);
+}
+
+Order make_order(uint64_t id) {
+    return Order{id, id * 10, 100.0 + id % 100, static_cast<int64_t>(id % 1000), "ACME", false};
+}
+
+struct Totals {
+    uint64_t checksum = 0;   // journaller
+    uint64_t rejected = 0;   // risk checker
+    uint64_t traded = 0;     // strategy
+    uint64_t errors = 0;     // strategy saw an order out of sequence or unchecked by risk
+};
+
+// --- Multicast: one write per order, every stage reads the same slot ---
+
+using OrderRing = MulticastRing<Order, 1024>;
+
+// Stage loop: process every sequence that is available, then release the batch
+template <typename Process>
+void stage_func(OrderRing& ring, OrderRing::Consumer& self, int count, Process process) {
+    int64_t next = 0;
+    while (next < count) {
+        const int64_t available = ring.wait_for(self, next);
+        for (; next <= available; ++next)
+            process(ring[next]);
+        ring.release(self, available);
+    }
+}
+
+Totals multicast_test(int count) {
+    OrderRing ring;
+    // The journaller and risk checker read an order as soon as it is published;
+    // the strategy only sees it once the risk checker has annotated it
+    OrderRing::Consumer& journaller = ring.add_consumer();
+    OrderRing::Consumer& risk = ring.add_consumer();
+    OrderRing::Consumer& strategy = ring.add_consumer({&risk});
+
+    Totals totals;
+    uint64_t expected = 0;
+    std::thread journal_thread([&]() {
+        stage_func(ring, journaller, count, [&](Order& o) { totals.checksum = journal(totals.checksum, o); });
+    });
+    std::thread risk_thread([&]() {
+        stage_func(ring, risk, count, [&](Order& o) {
+            o.approved = risk_check(o);   // annotated in place for the strategy
+            totals.rejected += !o.approved;
+        });
+    });
+    std::thread strategy_thread([&]() {
+        stage_func(ring, strategy, count, [&](Order& o) {
+            totals.errors += o.id != expected++ || o.approved != risk_check(o);
+            totals.traded += o.approved;
+        });
+    });
+
+    // Producer: claim a slot, fill it in place, publish
+    for (int i = 0; i < count; ++i) {
+        const int64_t seq = ring.claim();
+        ring[seq] = make_order(static_cast<uint64_t>(i));
+        ring.publish(seq);
+    }
+    journal_thread.join();
+    risk_thread.join();
+    strategy_thread.join();
+    return totals;
+}
+
+// --- Baseline: a copy of every order into a queue per stage ---
+
+using OrderQueue = LockFreeSPSCRingBuffer<Order, 1024>;
+
+Totals copying_test(int count) {
+    OrderQueue to_journal, to_risk, to_strategy;
+    Totals totals;
+    std::thread journal_thread([&]() {
+        for (int i = 0; i < count; ++i)
+            totals.checksum = journal(totals.checksum, to_journal.pop());
+    });
+    std::thread risk_thread([&]() {
+        for (int i = 0; i < count; ++i) {
+            Order o = to_risk.pop();
+            o.approved = risk_check(o);
+            totals.rejected += !o.approved;
+            to_strategy.push(o);
+        }
+    });
+    std::thread strategy_thread([&]() {
+        for (uint64_t expected = 0; expected < static_cast<uint64_t>(count); ++expected) {
+            const Order o = to_strategy.pop();
+            totals.errors += o.id != expected || o.approved != risk_check(o);
+            totals.traded += o.approved;
+        }
+    });
+
+    for (int i = 0; i < count; ++i) {
+        const Order o = make_order(static_cast<uint64_t>(i));
+        to_journal.push(o);
+        to_risk.push(o);
+    }
+    journal_thread.join();
+    risk_thread.join();
+    strategy_thread.join();
+    return totals;
+}
+
+// Function to time one pipeline and print what every stage saw
+template <typename Test>
+Totals run_test(const char* name, int count, Test test) {
+    auto start = std::chrono::steady_clock::now();
+    Totals totals = test(count);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << count << " orders in " << elapsed.count() << " s ("
+              << count / elapsed.count() / 1e6 << " M orders/s), checksum " << totals.checksum
+              << ", rejected " << totals.rejected << ", traded " << totals.traded << std::endl;
+    if (totals.errors)
+        std::cerr << "ERROR: strategy saw " << totals.errors << " orders out of sequence or unchecked" << std::endl;
+    return totals;
+}
+
+int main() {
+    const int ORDER_COUNT = 500000;
+
+    Totals multicast = run_test("multicast (1 write)", ORDER_COUNT, multicast_test);
+    Totals copying = run_test("3 SPSC queues (3 copies)", ORDER_COUNT, copying_test);
+
+    if (multicast.checksum != copying.checksum || multicast.traded != copying.traded)
+        std::cerr << "ERROR: the two pipelines disagree" << std::endl;
+
+    std::cout << "\nDisruptor Multicast Ring Test Complete." << std::endl;
+    return 0;
+}
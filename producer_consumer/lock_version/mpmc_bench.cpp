@@ -0,0 +1,103 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include "mpmc_queue.hpp"
+
+// Throughput of the lock-free MPMCQueue against the original mutex Buffer for
+// every combination of 1..N producers and 1..N consumers. Each run moves the
+// same number of items through a queue of 1024 slots and checks the sum.
+
+// --- Baseline: the original Buffer (one mutex, one condition variable, notify_all) ---
+
+class MutexBuffer
+{
+public:
+    void push(int num) {
+        std::unique_lock<std::mutex> locker(mu_);
+        cond_.wait(locker, [this](){return buffer_.size() < size_;});
+        buffer_.push_back(num);
+        locker.unlock();
+        cond_.notify_all();
+    }
+    int pop() {
+        std::unique_lock<std::mutex> locker(mu_);
+        cond_.wait(locker, [this](){return buffer_.size() > 0;});
+        int back = buffer_.back();
+        buffer_.pop_back();
+        locker.unlock();
+        cond_.notify_all();
+        return back;
+    }
+private:
+    std::mutex mu_;
+    std::condition_variable cond_;
+    std::deque<int> buffer_;
+    const unsigned int size_ = 1024;
+};
+
+// Million items per second with `producers` x `consumers` threads
+template <typename Queue>
+double run(int producers, int consumers, int items_per_pair) {
+    // Every producer's share divides evenly among the consumers
+    const long long per_producer = static_cast<long long>(items_per_pair) * consumers;
+    const long long per_consumer = static_cast<long long>(items_per_pair) * producers;
+    const long long total = per_producer * producers;
+
+    Queue queue;
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, per_producer]() {
+            for (long long i = 0; i < per_producer; ++i)
+                queue.push(static_cast<int>(i & 0xffff));
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&queue, &sum, per_consumer]() {
+            long long local = 0;
+            for (long long i = 0; i < per_consumer; ++i)
+                local += queue.pop();
+            sum.fetch_add(local);
+        });
+    }
+    for (std::thread& t : threads)
+        t.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    long long expected = 0;
+    for (long long i = 0; i < per_producer; ++i)
+        expected += i & 0xffff;
+    if (sum.load() != expected * producers)
+        std::cerr << "ERROR: checksum mismatch" << std::endl;
+    return total / elapsed.count() / 1e6;
+}
+
+// Usage: mpmc_bench [max_threads_per_side] [items_per_pair]
+int main(int argc, char* argv[]) {
+    const int max_threads = argc > 1 ? std::atoi(argv[1]) : 4;
+    const int items_per_pair = argc > 2 ? std::atoi(argv[2]) : 200000;
+
+    std::cout << "Items per producer/consumer pair: " << items_per_pair << ", capacity 1024, "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    std::cout << "  Producers  Consumers   Mutex [Mops/s]   MPMC [Mops/s]   Speedup" << std::endl;
+    for (int p = 1; p <= max_threads; ++p) {
+        for (int c = 1; c <= max_threads; ++c) {
+            const double mutex_mops = run<MutexBuffer>(p, c, items_per_pair);
+            const double mpmc_mops = run<MPMCQueue<int, 1024>>(p, c, items_per_pair);
+            std::cout << "  " << std::setw(9) << p << "  " << std::setw(9) << c
+                      << std::fixed << std::setprecision(2)
+                      << "  " << std::setw(15) << mutex_mops
+                      << "  " << std::setw(14) << mpmc_mops
+                      << "  " << std::setw(7) << mpmc_mops / mutex_mops << "x" << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,204 @@
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <new>
+#include <optional>
+#include <utility>
+#include "cache_line.hpp"
+#include "wait_strategy.hpp"
+#include "queue_stats.hpp"
+
+// Bounded multi-producer/multi-consumer FIFO queue (Dmitry Vyukov's array queue).
+//
+// Every cell carries a sequence number that says whose turn it is: a producer
+// may fill cell `pos & kMask` when its sequence equals pos, a consumer may empty
+// it when the sequence equals pos + 1. Producers claim positions with a CAS on
+// enqueue_pos_, consumers with a CAS on dequeue_pos_, so the only shared writes
+// are one CAS per operation plus the cell itself; no lock is taken on the fast
+// path.
+//
+// push/pop block when the queue is full/empty through the Wait policy
+// (wait_strategy.hpp). The default ParkingWait spins briefly, then sleeps on a
+// futex eventcount; the opposite side only makes the wake-up syscall when a
+// waiter is registered, and then wakes exactly one.
+//
+// Every operation reports to the Stats policy (queue_stats.hpp). With telemetry
+// on, a push also reads dequeue_pos_ to report the depth it left behind.
+template <typename T, size_t Capacity, typename Wait = ParkingWait, typename Stats = NoQueueStats>
+class MPMCQueue {
+public:
+    static_assert(Capacity >= 2, "Capacity must be at least 2");
+    static constexpr size_t kCapacity = round_up_pow2(Capacity);
+    static constexpr size_t kMask = kCapacity - 1;
+
+    MPMCQueue() : cells_(new Cell[kCapacity]) {
+        for (size_t i = 0; i < kCapacity; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~MPMCQueue() {
+        // Destroy the elements that were pushed but never popped
+        const size_t end = enqueue_pos_.load(std::memory_order_acquire);
+        for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != end; ++pos)
+            reinterpret_cast<T*>(cells_[pos & kMask].storage)->~T();
+        delete[] cells_;
+    }
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    // Constructs an element at the back; returns false if the queue is full
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        if (emplace_if_room(std::forward<Args>(args)...))
+            return true;
+        stats_.on_full();
+        return false;
+    }
+
+    bool try_push(const T& item) { return try_emplace(item); }
+    bool try_push(T&& item) { return try_emplace(std::move(item)); }
+
+    // Moves the front element out; returns false if the queue is empty
+    bool try_pop(T& item) {
+        if (pop_if_any(item))
+            return true;
+        stats_.on_empty();
+        return false;
+    }
+
+    // As try_pop, for a T without a default constructor: the element is
+    // move-constructed into `item`
+    bool try_pop(std::optional<T>& item) {
+        size_t pos;
+        if (Cell* cell = claim_front(pos)) {
+            item.emplace(take(cell, pos));
+            return true;
+        }
+        stats_.on_empty();
+        return false;
+    }
+
+    // Blocking push: waits while the queue is full
+    void push(T item) {
+        if (!try_push(std::move(item))) {
+            const uint64_t wait = stats_.wait_begin();
+            not_full_.wait_until([&]() { return emplace_if_room(std::move(item)); });
+            stats_.on_full_wait(wait);
+        }
+    }
+
+    // Blocking pop: waits while the queue is empty
+    T pop() {
+        size_t pos;
+        Cell* cell = claim_front(pos);
+        if (!cell) {
+            stats_.on_empty();
+            const uint64_t wait = stats_.wait_begin();
+            not_empty_.wait_until([&]() { return (cell = claim_front(pos)) != nullptr; });
+            stats_.on_empty_wait(wait);
+        }
+        return take(cell, pos);
+    }
+
+    // Telemetry sampled by a monitoring thread (Stats = QueueStats)
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    // try_emplace without the stall count, also retried by push() while it waits
+    template <typename... Args>
+    bool emplace_if_room(Args&&... args) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells_[pos & kMask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                // The cell is free for this lap: claim the position
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                // The cell still holds last lap's element: full
+                return false;
+            } else {
+                // Another producer took this position; retry with the current one
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        ::new (static_cast<void*>(cell->storage)) T(std::forward<Args>(args)...);
+        // RELEASE: the element is visible before consumers see the cell as full
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        not_empty_.notify();
+        if (Stats::kEnabled) {
+            const size_t out = dequeue_pos_.load(std::memory_order_relaxed);
+            stats_.on_enqueue(1, pos + 1 > out ? pos + 1 - out : 0);
+        }
+        return true;
+    }
+
+    // try_pop without the stall count
+    bool pop_if_any(T& item) {
+        size_t pos;
+        Cell* cell = claim_front(pos);
+        if (!cell)
+            return false;
+        item = take(cell, pos);
+        return true;
+    }
+
+    // Claims the front position for this consumer; nullptr if the queue is
+    // empty. Retried by pop() while it waits.
+    Cell* claim_front(size_t& pos) {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells_[pos & kMask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                // Not filled yet for this lap: empty
+                return nullptr;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        return cell;
+    }
+
+    // Moves the element out of a claimed cell and releases the cell
+    T take(Cell* cell, size_t pos) {
+        T* p = reinterpret_cast<T*>(cell->storage);
+        T item(std::move(*p));
+        p->~T();
+        // RELEASE: hand the cell to the producer of the next lap
+        cell->sequence.store(pos + kMask + 1, std::memory_order_release);
+        not_full_.notify();
+        stats_.on_dequeue(1);
+        return item;
+    }
+
+    alignas(kFalseSharingRange) std::atomic<size_t> enqueue_pos_{0};
+    alignas(kFalseSharingRange) std::atomic<size_t> dequeue_pos_{0};
+    alignas(kFalseSharingRange) Cell* const cells_;
+
+    // Where producers wait for space and consumers wait for data
+    alignas(kFalseSharingRange) Wait not_full_;
+    alignas(kFalseSharingRange) Wait not_empty_;
+
+    // Telemetry (empty unless Stats = QueueStats)
+    Stats stats_;
+};
+
+#endif
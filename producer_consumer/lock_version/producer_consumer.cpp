@@ -1,43 +1,33 @@
 #include <iostream>
 #include <thread>
-#include <deque>
-#include <mutex>
 #include <chrono>
-#include <condition_variable>
+#include <unistd.h>
+#include "mpmc_queue.hpp"
+#include "async_logger.hpp"
 
-using std::deque;
-std::mutex mu,cout_mu;
-std::condition_variable cond;
+// Threads hand their lines to the logger's background writer instead of
+// serializing on a console mutex (see async_logger.hpp)
+AsyncLogger logger(STDOUT_FILENO);
 
+// Bounded FIFO shared by all producers and consumers. Backed by the lock-free
+// MPMCQueue: no global lock on add/remove, and a blocked thread is only woken
+// (one at a time) when its side can make progress. The queue keeps telemetry
+// counters that the Monitor samples.
 class Buffer
 {
 public:
     void add(int num) {
-        while (true) {
-            std::unique_lock<std::mutex> locker(mu);
-            cond.wait(locker, [this](){return buffer_.size() < size_;});
-            buffer_.push_back(num);
-            locker.unlock();
-            cond.notify_all();
-            return;
-        }
+        queue_.push(num);
     }
     int remove() {
-        while (true)
-        {
-            std::unique_lock<std::mutex> locker(mu);
-            cond.wait(locker, [this](){return buffer_.size() > 0;});
-            int back = buffer_.back();
-            buffer_.pop_back();
-            locker.unlock();
-            cond.notify_all();
-            return back;
-        }
+        return queue_.pop();
+    }
+    QueueStatsSnapshot stats() const {
+        return queue_.stats().snapshot();
     }
     Buffer() {}
 private:
-    deque<int> buffer_;
-    const unsigned int size_ = 10;
+    MPMCQueue<int, 10, ParkingWait, QueueStats> queue_; // Rounded up to 16 slots
 };
 
 class Producer
@@ -52,11 +42,9 @@ public:
         while (true) {
             int num = std::rand() % 100;
             buffer_->add(num);
-            cout_mu.lock();
             int sleep_time = rand() % 100;
-            std::cout << "Name: " << name_ << "   Produced: " << num << "   Sleep time: " << sleep_time << std::endl;
+            logger.log("Name: {}   Produced: {}   Sleep time: {}", name_.c_str(), num, sleep_time);
             std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time));
-            cout_mu.unlock();
         }
     }
 private:
@@ -75,11 +63,9 @@ public:
     void run() {
         while (true) {
             int num = buffer_->remove();
-            cout_mu.lock();
             int sleep_time = rand() % 100;
-            std::cout << "Name: " << name_ << "   Consumed: " << num << "   Sleep time: " << sleep_time << std::endl;
+            logger.log("Name: {}   Consumed: {}   Sleep time: {}", name_.c_str(), num, sleep_time);
             std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time));
-            cout_mu.unlock();
         }
     }
 private:
@@ -87,6 +73,34 @@ private:
     std::string name_;
 };
 
+// Samples the buffer's counters every `interval_ms` and prints the rates, so a
+// full/empty queue (the bottleneck side) shows up without touching the hot path
+class Monitor
+{
+public:
+    Monitor(Buffer* buffer, int interval_ms)
+    {
+        this->buffer_ = buffer;
+        this->interval_ms_ = interval_ms;
+    }
+    void run() {
+        QueueStatsSnapshot last = buffer_->stats();
+        while (true) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms_));
+            const QueueStatsSnapshot now = buffer_->stats();
+            const QueueStatsSnapshot d = now.since(last);
+            last = now;
+            logger.log("[stats] in: {}   out: {}   depth: {}   high water: {}",
+                       d.enqueued, d.dequeued, now.depth(), now.high_water);
+            logger.log("[stats] full stalls: {} ({} ms)   empty stalls: {} ({} ms)",
+                       d.full_stalls, d.full_wait_ns / 1000000, d.empty_stalls, d.empty_wait_ns / 1000000);
+        }
+    }
+private:
+    Buffer *buffer_;
+    int interval_ms_;
+};
+
 int main() {
     Buffer b;
     Producer p1(&b, "producer1");
@@ -95,6 +109,7 @@ int main() {
     Consumer c1(&b, "consumer1");
     Consumer c2(&b, "consumer2");
     Consumer c3(&b, "consumer3");
+    Monitor m(&b, 2000);
 
     std::thread producer_thread1(&Producer::run, &p1);
     std::thread producer_thread2(&Producer::run, &p2);
@@ -104,12 +119,15 @@ int main() {
     std::thread consumer_thread2(&Consumer::run, &c2);
     std::thread consumer_thread3(&Consumer::run, &c3);
 
+    std::thread monitor_thread(&Monitor::run, &m);
+
     producer_thread1.join();
     producer_thread2.join();
     producer_thread3.join();
     consumer_thread1.join();
     consumer_thread2.join();
     consumer_thread3.join();
+    monitor_thread.join();
 
     getchar();
     return 0;
@@ -1,88 +1,27 @@
-#include <iostream>
 #include <thread>
 #include <vector>
 #include <chrono>
 #include <atomic>
-#include <mutex>
 #include <random> // Modern, thread-safe random number generation
 #include <ctime>  // For std::time
+#include <unistd.h>
+#include "spsc_queue.hpp"
+#include "async_logger.hpp"
 
-// Mutex remains for protecting the shared console output (std::cout)
-std::mutex cout_mu;
+// Console output goes through the logger's background writer, so neither side
+// blocks the other on a console mutex (see async_logger.hpp)
+AsyncLogger logger(STDOUT_FILENO);
 
-// --- LockFreeSPSCQueue Class (Minor fix in remove) ---
-
-class LockFreeSPSCQueue
-{
-private:
-    std::vector<int> buffer_;
-    const size_t size_; // Max capacity + 1 (to distinguish empty/full)
-    
-    // head_ is only written by the consumer and read by the producer/consumer.
-    std::atomic<size_t> head_ {0}; 
-    
-    // tail_ is only written by the producer and read by the producer/consumer.
-    std::atomic<size_t> tail_ {0}; 
-
-public:
-    LockFreeSPSCQueue(unsigned int capacity) 
-    : size_(capacity + 1), buffer_(capacity + 1) {}
-
-    void add(int num) {
-        size_t current_tail = tail_.load(std::memory_order_relaxed);
-        size_t next_tail = (current_tail + 1) % size_;
-        
-        // Busy wait until there is space
-        while (next_tail == head_.load(std::memory_order_acquire)) {
-            std::this_thread::yield(); 
-        }
-
-        // Write the data
-        buffer_[current_tail] = num;
-        
-        // Move the tail index (Release ensures data is visible)
-        tail_.store(next_tail, std::memory_order_release);
-    }
-    
-    int remove() {
-        int result;
-        size_t current_head;
-
-        while (true) {
-            // Read the head index (relaxed for initial check)
-            current_head = head_.load(std::memory_order_relaxed);
-            
-            // Check if queue is empty (head == tail)
-            // Acquire ensures the read sees the latest producer write
-            if (current_head == tail_.load(std::memory_order_acquire)) {
-                // Queue is empty, busy wait for the producer
-                std::this_thread::yield();
-            } else {
-                // Data is available, break the wait loop
-                break;
-            }
-        }
-
-        // Read the data
-        result = buffer_[current_head];
-        
-        // FIX: The index update logic should use current_head, not next_head 
-        // to calculate the *next* head value. The old code had next_head calculation 
-        // inside the loop, which wasn't necessary.
-        size_t next_head = (current_head + 1) % size_;
-        
-        // Move the head index (Release ensures the space is visible to the producer)
-        head_.store(next_head, std::memory_order_release);
-        return result;
-    }
-};
+// Rounded up to 16 slots. The threads sleep up to 100 ms between items, so the
+// waiting side parks on a futex instead of spinning (see wait_strategy.hpp)
+using IntQueue = LockFreeSPSCQueue<int, 10, ParkingWait>;
 
 // --- Producer Class (Fixed for thread-safe random number generation) ---
 
 class Producer
 {
 private:
-    LockFreeSPSCQueue *buffer_;
+    IntQueue *buffer_;
     std::string name_;
     // Thread-safe random engine and distribution
     std::mt19937 rand_engine;
@@ -90,7 +29,7 @@ private:
     std::uniform_int_distribution<int> sleep_dist{0, 99}; // 0 to 99 for sleep time
 
 public:
-    Producer(LockFreeSPSCQueue* buffer, std::string name)
+    Producer(IntQueue* buffer, std::string name)
     : buffer_(buffer), name_(name)
     {
         // Seed the engine uniquely using high-resolution clock
@@ -103,10 +42,8 @@ public:
             int num = num_dist(rand_engine);
             buffer_->add(num);
             
-            // Output protection remains a necessity
-            std::lock_guard<std::mutex> lock(cout_mu);
             int sleep_time = sleep_dist(rand_engine);
-            std::cout << "Name: " << name_ << "    Produced: " << num << "    Sleep time: " << sleep_time << "ms" << std::endl;
+            logger.log("Name: {}    Produced: {}    Sleep time: {}ms", name_.c_str(), num, sleep_time);
             std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time));
         }
     }
@@ -117,14 +54,14 @@ public:
 class Consumer
 {
 private:
-    LockFreeSPSCQueue *buffer_;
+    IntQueue *buffer_;
     std::string name_;
     // Thread-safe random engine and distribution
     std::mt19937 rand_engine;
     std::uniform_int_distribution<int> sleep_dist{0, 99}; // 0 to 99 for sleep time
     
 public:
-    Consumer(LockFreeSPSCQueue* buffer, std::string name)
+    Consumer(IntQueue* buffer, std::string name)
     : buffer_(buffer), name_(name)
     {
         // Seed the engine uniquely using high-resolution clock
@@ -135,10 +72,8 @@ public:
         while (true) {
             int num = buffer_->remove();
             
-            // Output protection remains a necessity
-            std::lock_guard<std::mutex> lock(cout_mu);
             int sleep_time = sleep_dist(rand_engine);
-            std::cout << "Name: " << name_ << "    Consumed: " << num << "    Sleep time: " << sleep_time << "ms" << std::endl;
+            logger.log("Name: {}    Consumed: {}    Sleep time: {}ms", name_.c_str(), num, sleep_time);
             std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time));
         }
     }
@@ -150,7 +85,7 @@ int main() {
     // We only need ctime for the random seed, but high_resolution_clock is better.
     // The srand() in main is also unnecessary now.
     
-    LockFreeSPSCQueue b(10);
+    IntQueue b;
     Producer p1(&b, "Producer_SPSC");
     Consumer c1(&b, "Consumer_SPSC");
 
@@ -0,0 +1,135 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <algorithm>
+#include <new>
+#include <utility>
+#include "cache_line.hpp"
+#include "wait_strategy.hpp"
+#include "queue_stats.hpp"
+
+// --- LockFreeSPSCQueue Class ---
+//
+// Blocking single-producer/single-consumer queue of T. add/remove wait through
+// the Wait policy (see wait_strategy.hpp) while the queue is full/empty; the
+// default spins briefly and then yields. Capacity is rounded up to a power of
+// two and head_/tail_ are free-running counters masked into the slot array, so
+// there is no modulus and no wasted slot. Slots are aligned raw storage: add()
+// move-constructs into a slot and remove() moves out and destroys it, so T may
+// be move-only.
+//
+// head_ and tail_ are padded onto separate lines, each next to its owner's
+// cached copy of the opposite counter; the opposite counter is only reloaded
+// from the other core's line when the cached copy says full/empty.
+//
+// add/remove report to the Stats policy (queue_stats.hpp): a full/empty stall
+// and the time waited each time they block.
+
+template <typename T, size_t Capacity, typename Wait = SpinYieldWait, typename Stats = NoQueueStats>
+class LockFreeSPSCQueue
+{
+public:
+    static_assert(Capacity > 0, "Capacity must be greater than 0");
+    static constexpr size_t kCapacity = round_up_pow2(Capacity);
+    static constexpr size_t kMask = kCapacity - 1;
+
+private:
+    static constexpr size_t kAlignment = std::max(alignof(T), kCacheLineSize);
+
+    // tail_ is only written by the producer; cached_head_ is the producer's last view of head_
+    alignas(kFalseSharingRange) std::atomic<size_t> tail_ {0};
+    size_t cached_head_ = 0;
+
+    // head_ is only written by the consumer; cached_tail_ is the consumer's last view of tail_
+    alignas(kFalseSharingRange) std::atomic<size_t> head_ {0};
+    size_t cached_tail_ = 0;
+
+    // Read-only after construction
+    alignas(kFalseSharingRange) T* slots_;
+
+    // Where the producer waits for space and the consumer waits for data
+    alignas(kFalseSharingRange) Wait not_full_;
+    alignas(kFalseSharingRange) Wait not_empty_;
+
+    // Telemetry (empty unless Stats = QueueStats)
+    Stats stats_;
+
+public:
+    LockFreeSPSCQueue()
+    : slots_(static_cast<T*>(::operator new(kCapacity * sizeof(T), std::align_val_t(kAlignment)))) {}
+
+    ~LockFreeSPSCQueue() {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        for (size_t i = head_.load(std::memory_order_relaxed); i != tail; ++i)
+            slots_[i & kMask].~T();
+        ::operator delete(slots_, std::align_val_t(kAlignment));
+    }
+
+    LockFreeSPSCQueue(const LockFreeSPSCQueue&) = delete;
+    LockFreeSPSCQueue& operator=(const LockFreeSPSCQueue&) = delete;
+
+    void add(T item) {
+        size_t current_tail = tail_.load(std::memory_order_relaxed);
+
+        // Wait until there is space; the consumer's line is only read when the
+        // cached head says the queue is full
+        if (current_tail - cached_head_ == kCapacity) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (current_tail - cached_head_ == kCapacity) {
+                stats_.on_full();
+                const uint64_t wait = stats_.wait_begin();
+                not_full_.wait_until([&]() {
+                    cached_head_ = head_.load(std::memory_order_acquire);
+                    return current_tail - cached_head_ != kCapacity;
+                });
+                stats_.on_full_wait(wait);
+            }
+        }
+
+        // Write the data
+        ::new (static_cast<void*>(&slots_[current_tail & kMask])) T(std::move(item));
+
+        // Move the tail counter (Release ensures data is visible)
+        tail_.store(current_tail + 1, std::memory_order_release);
+        not_empty_.notify();
+        stats_.on_enqueue(1, current_tail + 1 - cached_head_);
+    }
+
+    T remove() {
+        // Read the head counter (only the consumer writes it)
+        size_t current_head = head_.load(std::memory_order_relaxed);
+
+        // Check if queue is empty (head == tail), refreshing the cached tail first.
+        // Acquire ensures the read sees the latest producer write
+        if (current_head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (current_head == cached_tail_) {
+                // Queue is empty, wait for the producer
+                stats_.on_empty();
+                const uint64_t wait = stats_.wait_begin();
+                not_empty_.wait_until([&]() {
+                    cached_tail_ = tail_.load(std::memory_order_acquire);
+                    return current_head != cached_tail_;
+                });
+                stats_.on_empty_wait(wait);
+            }
+        }
+
+        // Read the data
+        T& slot = slots_[current_head & kMask];
+        T result = std::move(slot);
+        slot.~T();
+
+        // Move the head counter (Release ensures the space is visible to the producer)
+        head_.store(current_head + 1, std::memory_order_release);
+        not_full_.notify();
+        stats_.on_dequeue(1);
+        return result;
+    }
+
+    // Telemetry sampled by a monitoring thread (Stats = QueueStats)
+    const Stats& stats() const { return stats_; }
+};
+
+#endif
@@ -1,87 +1,19 @@
 #include <iostream>
 #include <vector>
-#include <atomic>
 #include <thread>
 #include <chrono>
+#include <algorithm>
+#include <memory>
+#include <cstdint>
+#include "spsc_ring_buffer.hpp"
 
 // The type of data we'll store
 using Data = int;
-
-class LockFreeSPSCRingBuffer {
-private:
-    // The buffer uses one extra element to distinguish between full and empty
-    std::vector<Data> buffer_; 
-    size_t capacity_;
-    
-    // The indices must be atomic for thread-safe reading/writing
-    // We use std::atomic<size_t> instead of a mutex
-    std::atomic<size_t> head_{0}; // Producer's index (where to write next)
-    std::atomic<size_t> tail_{0}; // Consumer's index (where to read next)
-
-public:
-    LockFreeSPSCRingBuffer(size_t capacity) : capacity_(capacity + 1), buffer_(capacity + 1) {
-        if (capacity == 0) {
-            // Internal capacity is size + 1
-            throw std::invalid_argument("Capacity must be greater than 0");
-        }
-        std::cout << "Buffer initialized with capacity for " << capacity << " items." << std::endl;
-    }
-
-    // Producer method: Attempts to add an element to the buffer
-    // Returns true on success, false if the buffer is full
-    bool try_push(const Data& item) {
-        // 1. Load the current indices
-        const size_t current_head = head_.load(std::memory_order_relaxed);
-        const size_t next_head = (current_head + 1) % capacity_;
-
-        // 2. Check for FULL condition
-        // The buffer is full if advancing head makes it equal to tail
-        if (next_head == tail_.load(std::memory_order_acquire)) {
-            // Failed: Buffer is full
-            return false;
-        }
-
-        // 3. Write the data (DATA access)
-        // Store the data into the calculated next head position
-        buffer_[current_head] = item;
-
-        // 4. Update the head index (INDEX access)
-        // We use RELEASE ordering to ensure the data write (step 3) completes
-        // BEFORE the head index is made visible to the Consumer thread.
-        head_.store(next_head, std::memory_order_release);
-        
-        return true;
-    }
-
-    // Consumer method: Attempts to read an element from the buffer
-    // Returns true on success, false if the buffer is empty
-    bool try_pop(Data& item) {
-        // 1. Load the current indices
-        const size_t current_tail = tail_.load(std::memory_order_relaxed);
-
-        // 2. Check for EMPTY condition
-        // The buffer is empty if head and tail are equal
-        if (current_tail == head_.load(std::memory_order_acquire)) {
-            // Failed: Buffer is empty
-            return false;
-        }
-
-        // 3. Read the data (DATA access)
-        // We use ACQUIRE ordering (above, when loading head) to ensure this data read
-        // happens AFTER the Producer's data write. This ensures we read valid data.
-        item = buffer_[current_tail];
-
-        // 4. Update the tail index (INDEX access)
-        const size_t next_tail = (current_tail + 1) % capacity_;
-        tail_.store(next_tail, std::memory_order_release);
-        
-        return true;
-    }
-};
+using RingBuffer = LockFreeSPSCRingBuffer<Data, 1024>; // Capacity of 1024 items
 
 // --- Example Usage ---
 
-void producer_func(LockFreeSPSCRingBuffer& buffer, int count) {
+void producer_func(RingBuffer& buffer, int count) {
     std::cout << "Producer started." << std::endl;
     for (int i = 1; i <= count; ++i) {
         // Busy-wait if buffer is full (typical in HFT to avoid sleeping)
@@ -97,7 +29,7 @@ void producer_func(LockFreeSPSCRingBuffer& buffer, int count) {
     std::cout << "Producer finished producing " << count << " items." << std::endl;
 }
 
-void consumer_func(LockFreeSPSCRingBuffer& buffer, int expected_count) {
+void consumer_func(RingBuffer& buffer, int expected_count) {
     std::cout << "Consumer started." << std::endl;
     int received_count = 0;
     Data item;
@@ -117,17 +49,150 @@ void consumer_func(LockFreeSPSCRingBuffer& buffer, int expected_count) {
     std::cout << "Consumer finished consuming " << received_count << " items." << std::endl;
 }
 
-int main() {
-    const int ITEM_COUNT = 500000;
-    LockFreeSPSCRingBuffer buffer(1024); // Capacity of 1024 items
+// Producer using the bulk API: pushes `count` items in bursts of up to `burst`
+void bulk_producer_func(RingBuffer& buffer, int count, size_t burst) {
+    std::vector<Data> items(burst);
+    int next = 1;
+    while (next <= count) {
+        const size_t n = std::min(burst, static_cast<size_t>(count - next + 1));
+        for (size_t i = 0; i < n; ++i)
+            items[i] = next + static_cast<int>(i);
+        size_t pushed = 0;
+        while (pushed < n) {
+            size_t done = buffer.push_n(items.data() + pushed, n - pushed);
+            if (done == 0)
+                std::this_thread::yield();
+            pushed += done;
+        }
+        next += static_cast<int>(n);
+    }
+}
 
-    // Start the threads
-    std::thread producer(producer_func, std::ref(buffer), ITEM_COUNT);
-    std::thread consumer(consumer_func, std::ref(buffer), ITEM_COUNT);
+// Producer using claim/commit: writes the items straight into the ring
+void claim_producer_func(RingBuffer& buffer, int count, size_t burst) {
+    int next = 1;
+    while (next <= count) {
+        RingBuffer::Span span = buffer.claim(std::min(burst, static_cast<size_t>(count - next + 1)));
+        if (span.size() == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < span.first_len; ++i)
+            span.first[i] = next++;
+        for (size_t i = 0; i < span.second_len; ++i)
+            span.second[i] = next++;
+        buffer.commit(span.size());
+    }
+}
 
-    // Wait for them to finish
+// Consumer using the bulk API: pops up to `burst` items at a time
+void bulk_consumer_func(RingBuffer& buffer, int expected_count, size_t burst) {
+    std::vector<Data> items(burst);
+    int received_count = 0;
+    while (received_count < expected_count) {
+        const size_t n = buffer.pop_n(items.data(), burst);
+        if (n == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            received_count++;
+            if (items[i] != received_count) {
+                std::cerr << "ERROR: Received value " << items[i] << " but expected " << received_count << std::endl;
+            }
+        }
+    }
+}
+
+// Function to time one producer/consumer pair over a fresh buffer
+template <typename ProducerFn, typename ConsumerFn>
+void run_test(const char* name, int count, ProducerFn producer_fn, ConsumerFn consumer_fn) {
+    RingBuffer buffer;
+    std::cout << "Buffer initialized with capacity for " << RingBuffer::kCapacity << " items." << std::endl;
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer(producer_fn, std::ref(buffer), count);
+    std::thread consumer(consumer_fn, std::ref(buffer), count);
     producer.join();
     consumer.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << count << " items in " << elapsed.count() << " s ("
+              << count / elapsed.count() / 1e6 << " M items/s)" << std::endl;
+}
+
+// A 64-byte message, as passed on the market-data path
+struct alignas(64) Message {
+    uint64_t sequence;
+    uint64_t timestamp;
+    double bid;
+    double ask;
+    char symbol[32];
+};
+static_assert(sizeof(Message) == 64, "Message should fill one cache line");
+
+// Function to stream 64-byte structs, constructed in place with try_emplace
+void message_test(int count) {
+    LockFreeSPSCRingBuffer<Message, 1000> buffer; // Rounded up to 1024
+    std::thread producer([&buffer, count]() {
+        for (int i = 1; i <= count; ++i) {
+            const Message m{static_cast<uint64_t>(i), 0, 100.0 + i, 100.5 + i, "ACME"};
+            while (!buffer.try_emplace(m))
+                std::this_thread::yield();
+        }
+    });
+    Message m;
+    for (int received = 1; received <= count; ++received) {
+        while (!buffer.try_pop(m))
+            std::this_thread::yield();
+        if (m.sequence != static_cast<uint64_t>(received) || m.bid != 100.0 + received)
+            std::cerr << "ERROR: Received message " << m.sequence << " but expected " << received << std::endl;
+    }
+    producer.join();
+    std::cout << "Message: " << count << " 64-byte messages through a ring of " << decltype(buffer)::kCapacity << std::endl;
+}
+
+// Function to stream a move-only type; items left in the ring are destroyed with it
+void unique_ptr_test(int count) {
+    LockFreeSPSCRingBuffer<std::unique_ptr<int>, 256> buffer;
+    std::thread producer([&buffer, count]() {
+        for (int i = 1; i <= count; ++i) {
+            std::unique_ptr<int> p(new int(i));
+            while (!buffer.try_push(std::move(p)))
+                std::this_thread::yield();
+        }
+    });
+    std::unique_ptr<int> p;
+    for (int received = 1; received <= count; ++received) {
+        while (!buffer.try_pop(p))
+            std::this_thread::yield();
+        if (*p != received)
+            std::cerr << "ERROR: Received value " << *p << " but expected " << received << std::endl;
+    }
+    producer.join();
+    for (int i = 0; i < 10; ++i)
+        buffer.try_push(std::unique_ptr<int>(new int(i)));
+    std::cout << "unique_ptr: " << count << " items moved through, 10 left for the destructor" << std::endl;
+}
+
+int main() {
+    const int ITEM_COUNT = 500000;
+    const size_t BURST = 256;
+
+    // One item per try_push/try_pop
+    run_test("try_push/try_pop", ITEM_COUNT, producer_func, consumer_func);
+
+    // Bursts: one index load and one index store per burst
+    run_test("push_n/pop_n", ITEM_COUNT,
+             [BURST](RingBuffer& b, int n) { bulk_producer_func(b, n, BURST); },
+             [BURST](RingBuffer& b, int n) { bulk_consumer_func(b, n, BURST); });
+
+    // Zero-copy producer: items are written in place, then committed
+    run_test("claim/commit", ITEM_COUNT,
+             [BURST](RingBuffer& b, int n) { claim_producer_func(b, n, BURST); },
+             [BURST](RingBuffer& b, int n) { bulk_consumer_func(b, n, BURST); });
+
+    // Non-trivial element types
+    message_test(ITEM_COUNT);
+    unique_ptr_test(ITEM_COUNT);
 
     std::cout << "\nLock-free SPSC Ring Buffer Test Complete." << std::endl;
     return 0;
@@ -0,0 +1,226 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <string>
+#include <cstdlib>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include "spsc_ring_buffer.hpp"
+#include "../lockfree_spsc/spsc_queue.hpp"
+
+// Throughput and latency of the SPSC queues with the producer and consumer pinned
+// to two different CPUs, then the wait strategies compared on a mostly idle
+// stream (wake-up latency vs. CPU burnt by the waiting consumer).
+//
+// "naive ring" is the original LockFreeSPSCRingBuffer: indices, buffer and
+// capacity packed together, the opposite index reloaded on every operation and a
+// runtime modulus per index update.
+// The gap to the padded/cached ring is the cross-core index traffic. To see the
+// traffic itself, run under `perf c2c record ./spsc_bench` (HITM counts) or
+// `perf stat -e mem_load_l3_hit_retired.xsnp_hitm ./spsc_bench`.
+
+// --- Baseline: the old layout ---
+
+using Data = int;
+
+class NaiveSPSCRingBuffer {
+private:
+    std::vector<Data> buffer_;
+    size_t capacity_;
+    std::atomic<size_t> head_{0};
+    std::atomic<size_t> tail_{0};
+
+public:
+    NaiveSPSCRingBuffer(size_t capacity = 1024) : buffer_(capacity + 1), capacity_(capacity + 1) {}
+
+    bool try_push(const Data& item) {
+        const size_t current_head = head_.load(std::memory_order_relaxed);
+        const size_t next_head = (current_head + 1) % capacity_;
+        if (next_head == tail_.load(std::memory_order_acquire))
+            return false;
+        buffer_[current_head] = item;
+        head_.store(next_head, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(Data& item) {
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+        if (current_tail == head_.load(std::memory_order_acquire))
+            return false;
+        item = buffer_[current_tail];
+        tail_.store((current_tail + 1) % capacity_, std::memory_order_release);
+        return true;
+    }
+};
+
+// --- Uniform blocking push/pop over the queue types ---
+
+// Spin with a pause; yield now and then so the benchmark also finishes when
+// both threads share one CPU
+inline void backoff(unsigned& spins) {
+    if (++spins % 64 == 0)
+        std::this_thread::yield();
+    else
+        cpu_relax();
+}
+
+template <typename Ring>
+void push(Ring& q, Data v) {
+    unsigned spins = 0;
+    while (!q.try_push(v))
+        backoff(spins);
+}
+
+template <typename Ring>
+Data pop(Ring& q) {
+    unsigned spins = 0;
+    Data v;
+    while (!q.try_pop(v))
+        backoff(spins);
+    return v;
+}
+
+template <size_t N>
+void push(LockFreeSPSCQueue<Data, N>& q, Data v) { q.add(v); }
+template <size_t N>
+Data pop(LockFreeSPSCQueue<Data, N>& q) { return q.remove(); }
+
+void pin_to_cpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+// --- Benchmarks ---
+
+// Million items per second through one queue, best of `reps`
+template <typename Queue>
+double throughput(int producer_cpu, int consumer_cpu, int items, int reps) {
+    double best = 0.0;
+    for (int r = 0; r < reps; ++r) {
+        Queue q;
+        std::atomic<bool> go{false};
+        long long sum = 0;
+        std::thread consumer([&]() {
+            pin_to_cpu(consumer_cpu);
+            while (!go.load(std::memory_order_acquire)) {}
+            for (int i = 0; i < items; ++i)
+                sum += pop(q);
+        });
+        pin_to_cpu(producer_cpu);
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (int i = 0; i < items; ++i)
+            push(q, i);
+        consumer.join();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (sum != static_cast<long long>(items) * (items - 1) / 2)
+            std::cerr << "ERROR: checksum mismatch" << std::endl;
+        best = std::max(best, items / elapsed.count() / 1e6);
+    }
+    return best;
+}
+
+// One-way latency in ns: half the round trip of a ping-pong over two queues
+template <typename Queue>
+double latency(int producer_cpu, int consumer_cpu, int round_trips) {
+    Queue ping, pong;
+    std::thread echo([&]() {
+        pin_to_cpu(consumer_cpu);
+        for (int i = 0; i < round_trips; ++i)
+            push(pong, pop(ping));
+    });
+    pin_to_cpu(producer_cpu);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < round_trips; ++i) {
+        push(ping, i);
+        if (pop(pong) != i)
+            std::cerr << "ERROR: ping-pong out of order" << std::endl;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    echo.join();
+    return elapsed.count() * 1e9 / round_trips / 2;
+}
+
+template <typename Queue>
+void report(const char* name, int producer_cpu, int consumer_cpu, int items, int reps) {
+    const double mops = throughput<Queue>(producer_cpu, consumer_cpu, items, reps);
+    const double ns = latency<Queue>(producer_cpu, consumer_cpu, items / 100);
+    std::cout << "  " << std::left << std::setw(24) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(1) << mops
+              << std::setw(14) << ns << std::endl;
+}
+
+// --- Idle stream: one item per millisecond ---
+
+inline long long now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// CPU time consumed by the calling thread
+double thread_cpu_seconds() {
+    struct rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+template <typename Wait>
+void idle_report(const char* name, int producer_cpu, int consumer_cpu, int messages) {
+    LockFreeSPSCRingBuffer<long long, 1024, Wait> ring;
+    long long latency_total = 0;
+    double consumer_cpu_seconds = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer([&]() {
+        pin_to_cpu(consumer_cpu);
+        const double cpu_start = thread_cpu_seconds();
+        for (int i = 0; i < messages; ++i) {
+            const long long sent = ring.pop();
+            latency_total += now_ns() - sent;
+        }
+        consumer_cpu_seconds = thread_cpu_seconds() - cpu_start;
+    });
+    pin_to_cpu(producer_cpu);
+    for (int i = 0; i < messages; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ring.push(now_ns());
+    }
+    consumer.join();
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+    std::cout << "  " << std::left << std::setw(24) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(2) << latency_total / 1e3 / messages
+              << std::setw(14) << std::setprecision(1) << 100.0 * consumer_cpu_seconds / wall.count() << std::endl;
+}
+
+// Usage: spsc_bench [producer_cpu] [consumer_cpu] [items]
+int main(int argc, char* argv[]) {
+    const int cpus = static_cast<int>(std::thread::hardware_concurrency());
+    const int producer_cpu = argc > 1 ? std::atoi(argv[1]) : 0;
+    const int consumer_cpu = argc > 2 ? std::atoi(argv[2]) : std::min(1, cpus - 1);
+    const int items = argc > 3 ? std::atoi(argv[3]) : 10000000;
+    const int reps = 3;
+
+    std::cout << "Producer on CPU " << producer_cpu << ", consumer on CPU " << consumer_cpu
+              << ", " << items << " items, capacity 1024" << std::endl;
+    if (producer_cpu == consumer_cpu)
+        std::cout << "(same CPU: no cross-core traffic to save, numbers are scheduler-bound)" << std::endl;
+    std::cout << "  Queue                      Mops/s  latency [ns]" << std::endl;
+    report<NaiveSPSCRingBuffer>("naive ring", producer_cpu, consumer_cpu, items, reps);
+    report<LockFreeSPSCRingBuffer<Data, 1024>>("padded + cached ring", producer_cpu, consumer_cpu, items, reps);
+    report<LockFreeSPSCRingBuffer<Data, 1024, SpinYieldWait, QueueStats>>("  + QueueStats", producer_cpu, consumer_cpu, items, reps);
+    report<LockFreeSPSCQueue<Data, 1024>>("LockFreeSPSCQueue", producer_cpu, consumer_cpu, items, reps);
+
+    const int messages = 500;
+    std::cout << std::endl << "Idle stream: " << messages << " items, one per millisecond" << std::endl;
+    std::cout << "  Wait strategy         wake-up [us]  consumer CPU %" << std::endl;
+    idle_report<BusySpinWait>("BusySpinWait", producer_cpu, consumer_cpu, messages);
+    idle_report<SpinYieldWait>("SpinYieldWait", producer_cpu, consumer_cpu, messages);
+    idle_report<ParkingWait>("ParkingWait", producer_cpu, consumer_cpu, messages);
+    return 0;
+}
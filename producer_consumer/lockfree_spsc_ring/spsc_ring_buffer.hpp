@@ -0,0 +1,309 @@
+#ifndef SPSC_RING_BUFFER_HPP
+#define SPSC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "cache_line.hpp"
+#include "wait_strategy.hpp"
+#include "queue_stats.hpp"
+
+// Single-producer/single-consumer ring buffer of T.
+//
+// Capacity is rounded up to a power of two. head_ and tail_ are free-running
+// counters: the slot is `counter & kMask`, the ring holds head_ - tail_ items,
+// and all kCapacity slots are usable (no empty slot is needed to tell full from
+// empty). Elements live in cache-line-aligned raw storage and are constructed
+// with placement new on push and destroyed on pop, so T may be non-trivial or
+// move-only (e.g. std::unique_ptr).
+//
+// Layout: each side's counter lives on its own kFalseSharingRange-aligned line
+// together with that side's cached copy of the opposite counter, and the storage
+// pointer sits on a third line. The producer only reloads the consumer's tail_
+// when the ring looks full from its cached copy, and the consumer only reloads
+// head_ when the ring looks empty, so in steady state the counter lines move
+// between cores once per lap rather than once per item.
+//
+// try_* never block. push/pop wait through the Wait policy (wait_strategy.hpp);
+// every operation that publishes items or frees slots notifies the other side.
+// Every operation also reports to the Stats policy (queue_stats.hpp); the depth
+// reported on push is against the producer's cached tail, an upper bound.
+template <typename T, size_t Capacity, typename Wait = SpinYieldWait, typename Stats = NoQueueStats>
+class LockFreeSPSCRingBuffer {
+public:
+    static_assert(Capacity > 0, "Capacity must be greater than 0");
+    static constexpr size_t kCapacity = round_up_pow2(Capacity);
+    static constexpr size_t kMask = kCapacity - 1;
+
+private:
+    static constexpr size_t kAlignment = std::max(alignof(T), kCacheLineSize);
+
+    // --- Producer line ---
+    alignas(kFalseSharingRange) std::atomic<size_t> head_{0}; // Producer's counter (where to write next)
+    size_t cached_tail_ = 0;                                   // Producer's last view of tail_
+
+    // --- Consumer line ---
+    alignas(kFalseSharingRange) std::atomic<size_t> tail_{0}; // Consumer's counter (where to read next)
+    size_t cached_head_ = 0;                                   // Consumer's last view of head_
+
+    // --- Shared, read-only after construction ---
+    alignas(kFalseSharingRange) T* slots_;
+
+    // Where the producer waits for space and the consumer waits for data
+    alignas(kFalseSharingRange) Wait not_full_;
+    alignas(kFalseSharingRange) Wait not_empty_;
+
+    // Telemetry (empty unless Stats = QueueStats)
+    Stats stats_;
+
+public:
+    LockFreeSPSCRingBuffer()
+        : slots_(static_cast<T*>(::operator new(kCapacity * sizeof(T), std::align_val_t(kAlignment)))) {}
+
+    ~LockFreeSPSCRingBuffer() {
+        // Destroy whatever was pushed but never popped
+        const size_t head = head_.load(std::memory_order_acquire);
+        for (size_t i = tail_.load(std::memory_order_relaxed); i != head; ++i)
+            slot(i)->~T();
+        ::operator delete(slots_, std::align_val_t(kAlignment));
+    }
+
+    LockFreeSPSCRingBuffer(const LockFreeSPSCRingBuffer&) = delete;
+    LockFreeSPSCRingBuffer& operator=(const LockFreeSPSCRingBuffer&) = delete;
+
+    // Producer method: Attempts to construct an element in the buffer from `args`
+    // Returns true on success, false if the buffer is full (args are left untouched)
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        if (emplace_if_room(std::forward<Args>(args)...))
+            return true;
+        stats_.on_full();
+        return false;
+    }
+
+    bool try_push(const T& item) { return try_emplace(item); }
+    bool try_push(T&& item) { return try_emplace(std::move(item)); }
+
+    // Consumer method: Attempts to move an element out of the buffer
+    // Returns true on success, false if the buffer is empty
+    bool try_pop(T& item) {
+        if (pop_if_any(item))
+            return true;
+        stats_.on_empty();
+        return false;
+    }
+
+    // Producer method: Pushes an element, waiting while the buffer is full
+    void push(T item) {
+        if (!try_push(std::move(item))) {
+            const uint64_t wait = stats_.wait_begin();
+            not_full_.wait_until([&]() { return emplace_if_room(std::move(item)); });
+            stats_.on_full_wait(wait);
+        }
+    }
+
+    // Consumer method: Pops an element, waiting while the buffer is empty
+    // The result is move-constructed from the slot, so T need not be default-constructible
+    T pop() {
+        if (!has_item()) {
+            stats_.on_empty();
+            const uint64_t wait = stats_.wait_begin();
+            not_empty_.wait_until([&]() { return has_item(); });
+            stats_.on_empty_wait(wait);
+        }
+        return take_front();
+    }
+
+    // Telemetry sampled by a monitoring thread (Stats = QueueStats)
+    const Stats& stats() const { return stats_; }
+
+    // --- Bulk API ---
+    // One acquire load of the other side's counter (and only when the cached copy
+    // is short) and one release store of our own counter per call.
+
+    // A contiguous region of the ring; wraparound splits it into two spans
+    struct Span {
+        T* first = nullptr;
+        size_t first_len = 0;
+        T* second = nullptr;
+        size_t second_len = 0;
+        size_t size() const { return first_len + second_len; }
+    };
+
+    // Producer method: Copies up to `count` items into the buffer
+    // Returns the number of items pushed (0 if the buffer is full)
+    size_t push_n(const T* items, size_t count) {
+        Span span = claim(count);
+        std::uninitialized_copy(items, items + span.first_len, span.first);
+        std::uninitialized_copy(items + span.first_len, items + span.size(), span.second);
+        commit(span.size());
+        return span.size();
+    }
+
+    // Consumer method: Moves up to `max_count` items out of the buffer
+    // Returns the number of items popped (0 if the buffer is empty)
+    size_t pop_n(T* items, size_t max_count) {
+        Span span = peek(max_count);
+        std::move(span.first, span.first + span.first_len, items);
+        std::move(span.second, span.second + span.second_len, items + span.first_len);
+        consume(span.size());
+        return span.size();
+    }
+
+    // Producer method: Reserves up to `count` free slots for writing in place.
+    // The slots are raw storage: construct each element with placement new
+    // (trivially copyable T may simply be assigned). They are invisible to the
+    // consumer until commit().
+    Span claim(size_t count) {
+        // 1. Load the current counter
+        const size_t current_head = head_.load(std::memory_order_relaxed);
+
+        // 2. Free slots; refresh the cached tail only if it cannot satisfy the request
+        size_t free_slots = kCapacity - (current_head - cached_tail_);
+        if (free_slots < count) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            free_slots = kCapacity - (current_head - cached_tail_);
+        }
+        if (free_slots == 0 && count > 0)
+            stats_.on_full();
+        return make_span(current_head, std::min(count, free_slots));
+    }
+
+    // Producer method: Publishes the first `count` slots of the last claim()
+    void commit(size_t count) {
+        const size_t current_head = head_.load(std::memory_order_relaxed);
+        // RELEASE: every write into the claimed slots is visible before the new head
+        head_.store(current_head + count, std::memory_order_release);
+        not_empty_.notify();
+        stats_.on_enqueue(count, current_head + count - cached_tail_);
+    }
+
+    // Consumer method: Exposes up to `max_count` readable items in place
+    // The items stay owned by the ring until consume()
+    Span peek(size_t max_count) {
+        // 1. Load the current counter
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+
+        // 2. Readable items between tail and the (cached, then fresh) head
+        size_t used_slots = cached_head_ - current_tail;
+        if (used_slots < max_count) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            used_slots = cached_head_ - current_tail;
+        }
+        if (used_slots == 0 && max_count > 0)
+            stats_.on_empty();
+        return make_span(current_tail, std::min(max_count, used_slots));
+    }
+
+    // Consumer method: Destroys the first `count` items of the last peek() and
+    // hands their slots back to the producer
+    void consume(size_t count) {
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+        if (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = 0; i < count; ++i)
+                slot(current_tail + i)->~T();
+        }
+        tail_.store(current_tail + count, std::memory_order_release);
+        not_full_.notify();
+        stats_.on_dequeue(count);
+    }
+
+private:
+    // try_emplace without the stall count, also retried by push() while it waits
+    template <typename... Args>
+    bool emplace_if_room(Args&&... args) {
+        // 1. Load the current counters
+        const size_t current_head = head_.load(std::memory_order_relaxed);
+
+        // 2. Check for FULL condition against the cached tail first; only when
+        //    that says full is the consumer's line actually read
+        if (current_head - cached_tail_ == kCapacity) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (current_head - cached_tail_ == kCapacity) {
+                // Failed: Buffer is full
+                return false;
+            }
+        }
+
+        // 3. Construct the data in its slot (DATA access)
+        ::new (static_cast<void*>(slot(current_head))) T(std::forward<Args>(args)...);
+
+        // 4. Update the head counter (INDEX access)
+        // We use RELEASE ordering to ensure the construction (step 3) completes
+        // BEFORE the new head is made visible to the Consumer thread.
+        head_.store(current_head + 1, std::memory_order_release);
+        not_empty_.notify();
+        stats_.on_enqueue(1, current_head + 1 - cached_tail_);
+
+        return true;
+    }
+
+    // try_pop without the stall count, also retried by pop() while it waits
+    bool pop_if_any(T& item) {
+        // 1. Load the current counters
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+
+        // 2. Check for EMPTY condition against the cached head first
+        if (current_tail == cached_head_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (current_tail == cached_head_) {
+                // Failed: Buffer is empty
+                return false;
+            }
+        }
+
+        // 3. Move the data out and destroy the slot (DATA access)
+        // The ACQUIRE load that refreshed cached_head_ ordered this read after the
+        // Producer's construction.
+        T* p = slot(current_tail);
+        item = std::move(*p);
+        p->~T();
+
+        // 4. Update the tail counter (INDEX access)
+        tail_.store(current_tail + 1, std::memory_order_release);
+        not_full_.notify();
+        stats_.on_dequeue(1);
+
+        return true;
+    }
+
+    // Whether the consumer has an item to read, reloading head_ only when the
+    // cached copy says empty
+    bool has_item() {
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+        if (current_tail != cached_head_)
+            return true;
+        cached_head_ = head_.load(std::memory_order_acquire);
+        return current_tail != cached_head_;
+    }
+
+    // pop_if_any for a known non-empty buffer, constructing the result in place
+    T take_front() {
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+        T* p = slot(current_tail);
+        T item(std::move(*p));
+        p->~T();
+        tail_.store(current_tail + 1, std::memory_order_release);
+        not_full_.notify();
+        stats_.on_dequeue(1);
+        return item;
+    }
+
+    T* slot(size_t counter) const { return slots_ + (counter & kMask); }
+
+    // `count` slots starting at `counter`, split at the end of the storage
+    Span make_span(size_t counter, size_t count) const {
+        const size_t index = counter & kMask;
+        Span span;
+        span.first = slots_ + index;
+        span.first_len = std::min(count, kCapacity - index);
+        span.second = slots_;
+        span.second_len = count - span.first_len;
+        return span;
+    }
+};
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef MULTILEVEL_QUEUE_HPP
+#define MULTILEVEL_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include "cache_line.hpp"
+#include "wait_strategy.hpp"
+#include "mpmc_queue.hpp"
+
+// Bounded multi-producer/multi-consumer priority queue with optional deadlines.
+//
+// One MPMCQueue ring per priority class (0 is the most urgent), each with its
+// own capacity, so a flood of bulk items can only fill its own ring: control
+// messages never sit behind it. Consumers always take from the most urgent
+// non-empty class; within a class the order is FIFO. Selection is lock-free:
+// nonempty_ holds one bit per class, and a consumer takes the lowest set bit
+// with a single load instead of probing every ring.
+//
+// The bits are a hint kept conservative in one direction: a set bit may point
+// at a ring that has just been drained, but a non-empty ring never has its bit
+// clear for good. A producer sets the bit after its push (skipping the RMW when
+// it is already set); a consumer that finds a flagged ring empty clears the bit
+// and then re-checks the ring. Both sides put a seq_cst fence between their
+// write and their read, so either the producer sees the cleared bit and sets
+// it again or the consumer's re-check finds the item.
+//
+// Selection is strict: a class is only served while every more urgent class is
+// empty, so a sustained urgent load starves the classes below it.
+//
+// An item may carry a deadline (steady_clock). Consumers drop items whose
+// deadline has passed instead of returning them, counting them per class;
+// the clock is only read when an item with a deadline is popped.
+//
+// push/pop block through the Wait policy (wait_strategy.hpp): producers on
+// their class's not_full, consumers on one not_empty shared by all classes.
+template <typename T, size_t Levels, size_t CapacityPerLevel, typename Wait = ParkingWait>
+class MultiLevelQueue {
+public:
+    static_assert(Levels >= 1 && Levels <= 64, "Levels must be between 1 and 64 (one bit each)");
+
+    using Clock = std::chrono::steady_clock;
+    static constexpr Clock::time_point kNoDeadline = Clock::time_point::max();
+    static constexpr size_t kLevels = Levels;
+
+    MultiLevelQueue() {}
+
+    MultiLevelQueue(const MultiLevelQueue&) = delete;
+    MultiLevelQueue& operator=(const MultiLevelQueue&) = delete;
+
+    // Producer method: Attempts to enqueue `item` in class `priority`
+    // Returns false if that class is full
+    bool try_push(T item, size_t priority, Clock::time_point deadline = kNoDeadline) {
+        Entry entry{std::move(item), to_ns(deadline)};
+        return push_entry(priority, entry);
+    }
+
+    // Producer method: Enqueues `item` in class `priority`, waiting while that
+    // class is full
+    void push(T item, size_t priority, Clock::time_point deadline = kNoDeadline) {
+        Entry entry{std::move(item), to_ns(deadline)};
+        if (!push_entry(priority, entry))
+            levels_[priority].not_full.wait_until([&]() { return push_entry(priority, entry); });
+    }
+
+    // Consumer method: Attempts to dequeue the most urgent live item; expired
+    // items met on the way are dropped
+    // Returns false if every class is empty
+    bool try_pop(T& item) { return pop_value(item, nullptr); }
+
+    // As try_pop, and reports the item's class in `priority`
+    bool try_pop(T& item, size_t& priority) { return pop_value(item, &priority); }
+
+    // Consumer method: Dequeues the most urgent live item, waiting while every
+    // class is empty
+    T pop() {
+        std::optional<T> item;
+        if (!pop_entry(item, nullptr))
+            not_empty_.wait_until([&]() { return pop_entry(item, nullptr); });
+        return std::move(*item);
+    }
+
+    // Items dropped so far because their deadline had passed
+    uint64_t expired(size_t priority) const {
+        return levels_[priority].expired.load(std::memory_order_relaxed);
+    }
+    uint64_t expired() const {
+        uint64_t total = 0;
+        for (const Level& level : levels_)
+            total += level.expired.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    static constexpr int64_t kNoDeadlineNs = INT64_MAX;
+
+    struct Entry {
+        T value;
+        int64_t deadline_ns;   // steady_clock, kNoDeadlineNs if none
+    };
+
+    struct Level {
+        MPMCQueue<Entry, CapacityPerLevel, BusySpinWait> queue;   // waiting is done here, not in the ring
+        alignas(kFalseSharingRange) Wait not_full;
+        alignas(kFalseSharingRange) std::atomic<uint64_t> expired{0};
+    };
+
+    bool push_entry(size_t priority, Entry& entry) {
+        // 1. Publish the entry in its class's ring (left untouched if full)
+        if (!levels_[priority].queue.try_push(std::move(entry)))
+            return false;
+
+        // 2. Flag the class as non-empty, then wake a consumer
+        mark_nonempty(priority);
+        not_empty_.notify();
+        return true;
+    }
+
+    bool pop_value(T& item, size_t* priority) {
+        std::optional<T> popped;
+        if (!pop_entry(popped, priority))
+            return false;
+        item = std::move(*popped);
+        return true;
+    }
+
+    // Constructs the item in `item`, so T needs no default constructor
+    bool pop_entry(std::optional<T>& item, size_t* priority) {
+        int64_t now_ns = 0;   // read lazily, once per call
+        uint64_t mask = nonempty_.load(std::memory_order_acquire);
+        while (mask != 0) {
+            // 1. Most urgent flagged class
+            const size_t level_index = static_cast<size_t>(__builtin_ctzll(mask));
+            Level& level = levels_[level_index];
+
+            // 2. Take its oldest entry; if the ring turned out empty, clear the
+            //    bit and look once more for a push that raced with the clear
+            std::optional<Entry> entry;
+            bool got = level.queue.try_pop(entry);
+            if (!got) {
+                nonempty_.fetch_and(~(uint64_t(1) << level_index), std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                got = level.queue.try_pop(entry);
+                if (got)
+                    mark_nonempty(level_index);   // more may be queued behind it
+            }
+
+            // 3. Hand it over unless it is stale
+            if (got) {
+                level.not_full.notify();
+                if (entry->deadline_ns != kNoDeadlineNs) {
+                    if (now_ns == 0)
+                        now_ns = to_ns(Clock::now());
+                    if (entry->deadline_ns <= now_ns) {
+                        level.expired.fetch_add(1, std::memory_order_relaxed);
+                        mask = nonempty_.load(std::memory_order_acquire);
+                        continue;
+                    }
+                }
+                item.emplace(std::move(entry->value));
+                if (priority)
+                    *priority = level_index;
+                return true;
+            }
+            mask = nonempty_.load(std::memory_order_acquire);
+        }
+        return false;
+    }
+
+    void mark_nonempty(size_t level_index) {
+        const uint64_t bit = uint64_t(1) << level_index;
+        // Pairs with the fence in pop_entry (store of the item / load of the bit)
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!(nonempty_.load(std::memory_order_relaxed) & bit))
+            nonempty_.fetch_or(bit, std::memory_order_release);
+    }
+
+    static int64_t to_ns(Clock::time_point t) {
+        if (t == kNoDeadline)
+            return kNoDeadlineNs;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+    // Bit i set: class i may hold items
+    alignas(kFalseSharingRange) std::atomic<uint64_t> nonempty_{0};
+
+    // Where consumers wait for an item of any class
+    alignas(kFalseSharingRange) Wait not_empty_;
+
+    Level levels_[Levels];
+};
+
+#endif
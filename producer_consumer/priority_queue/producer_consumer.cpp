@@ -0,0 +1,146 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include "multilevel_queue.hpp"
+#include "mpmc_queue.hpp"
+#include "latency_histogram.hpp"
+
+// Overload test: a bulk producer floods the queue faster than the consumer can
+// keep up (each bulk item costs ~2 us of work), while a control producer sends
+// a message every 2 ms. With one FIFO, every control message waits behind the
+// full backlog of bulk items; with a MultiLevelQueue it waits for at most the
+// item in progress. A third run gives the bulk items a deadline, so the stale
+// ones are dropped in the queue instead of being worked on.
+
+using Clock = std::chrono::steady_clock;
+
+enum Kind : uint32_t { kControl, kBulk, kStop };
+
+struct Message {
+    Kind kind = kBulk;
+    int64_t sent_ns = 0;
+};
+
+const int kBulkItems = 300000;
+const int kControlItems = 200;
+const int kCapacity = 4096;
+const auto kBulkWork = std::chrono::microseconds(2);
+const auto kControlInterval = std::chrono::milliseconds(2);
+const auto kBulkDeadline = std::chrono::milliseconds(1);
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+void spin_for(Clock::duration d) {
+    const Clock::time_point end = Clock::now() + d;
+    while (Clock::now() < end) {}
+}
+
+struct Result {
+    LatencyHistogram control_us;
+    uint64_t bulk_done = 0;
+    uint64_t bulk_stale = 0;   // worked on although older than kBulkDeadline
+    uint64_t bulk_expired = 0;
+    double seconds = 0;
+};
+
+// Runs both producers and one consumer; push_control/push_bulk/pop wrap the queue
+template <typename PushControl, typename PushBulk, typename Pop>
+Result run(PushControl push_control, PushBulk push_bulk, Pop pop) {
+    Result r;
+    const Clock::time_point start = Clock::now();
+
+    std::thread consumer([&]() {
+        const int64_t stale_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(kBulkDeadline).count();
+        while (true) {
+            const Message m = pop();
+            if (m.kind == kStop)
+                break;
+            const int64_t age = now_ns() - m.sent_ns;
+            if (m.kind == kControl) {
+                r.control_us.record(static_cast<uint64_t>(age / 1000));
+            } else {
+                r.bulk_stale += age > stale_ns;
+                ++r.bulk_done;
+                spin_for(kBulkWork);
+            }
+        }
+    });
+    std::thread bulk([&]() {
+        for (int i = 0; i < kBulkItems; ++i)
+            push_bulk(Message{kBulk, now_ns()});
+    });
+    std::thread control([&]() {
+        for (int i = 0; i < kControlItems; ++i) {
+            std::this_thread::sleep_for(kControlInterval);
+            push_control(Message{kControl, now_ns()});
+        }
+    });
+
+    bulk.join();
+    control.join();
+    push_bulk(Message{kStop, now_ns()});   // behind every bulk item still queued
+    consumer.join();
+
+    r.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return r;
+}
+
+void print(const char* name, const Result& r) {
+    std::cout << std::left << std::setw(26) << name << std::right
+              << std::setw(10) << r.control_us.percentile(50.0)
+              << std::setw(10) << r.control_us.percentile(99.0)
+              << std::setw(10) << r.control_us.max()
+              << std::setw(12) << r.bulk_done
+              << std::setw(10) << r.bulk_stale
+              << std::setw(10) << r.bulk_expired
+              << std::setw(9) << std::fixed << std::setprecision(2) << r.seconds << std::endl;
+}
+
+int main() {
+    std::cout << "Overload: " << kBulkItems << " bulk items (~2 us of work each) and "
+              << kControlItems << " control messages every 2 ms, one consumer" << std::endl;
+    std::cout << std::left << std::setw(26) << "queue" << std::right
+              << std::setw(10) << "ctl p50" << std::setw(10) << "ctl p99" << std::setw(10) << "ctl max"
+              << std::setw(12) << "bulk done" << std::setw(10) << "stale" << std::setw(10) << "expired"
+              << std::setw(9) << "s" << std::endl;
+    std::cout << std::left << std::setw(26) << "" << std::right
+              << std::setw(30) << "(control latency, us)" << std::endl;
+
+    // --- One FIFO for everything ---
+    {
+        MPMCQueue<Message, kCapacity> fifo;
+        const Result r = run([&](Message m) { fifo.push(m); },
+                             [&](Message m) { fifo.push(m); },
+                             [&]() { return fifo.pop(); });
+        print("MPMCQueue (FIFO)", r);
+    }
+
+    // --- One class per kind ---
+    {
+        MultiLevelQueue<Message, 2, kCapacity> queue;
+        const Result r = run([&](Message m) { queue.push(m, 0); },
+                             [&](Message m) { queue.push(m, 1); },
+                             [&]() { return queue.pop(); });
+        print("MultiLevelQueue", r);
+    }
+
+    // --- Bulk items expire after 1 ms ---
+    {
+        MultiLevelQueue<Message, 2, kCapacity> queue;
+        Result r = run([&](Message m) { queue.push(m, 0); },
+                       [&](Message m) {
+                           const auto deadline = m.kind == kStop ? queue.kNoDeadline : Clock::now() + kBulkDeadline;
+                           queue.push(m, 1, deadline);
+                       },
+                       [&]() { return queue.pop(); });
+        r.bulk_expired = queue.expired(1);
+        print("MultiLevelQueue + 1 ms", r);
+    }
+
+    std::cout << "\nPriority Queue Test Complete." << std::endl;
+    return 0;
+}
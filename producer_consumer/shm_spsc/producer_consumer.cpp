@@ -0,0 +1,253 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "shm_ring.hpp"
+
+// A market-data tick, as passed from the feed handler to the strategy
+struct Tick {
+    uint64_t sequence;
+    uint64_t timestamp;
+    double bid;
+    double ask;
+};
+
+using TickRing = ShmSPSCRing<Tick>;
+
+const uint64_t kPeerTimeoutNs = 100000000;   // 100 ms without a heartbeat = dead
+
+// --- Separate-process mode ---
+
+// Producer process: creates the segment and streams `count` ticks into it
+int run_producer(const std::string& name, int count) {
+    TickRing ring = TickRing::create(name, 4096, ShmSide::Producer);
+    std::cout << "Producer: created " << name << " with " << ring.capacity() << " slots, waiting for a consumer" << std::endl;
+    while (!ring.peer_attached()) {
+        ring.heartbeat();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (int i = 1; i <= count; ++i) {
+        const Tick t{static_cast<uint64_t>(i), monotonic_ns(), 100.0 + i % 100, 100.5 + i % 100};
+        while (!ring.try_push(t)) {
+            ring.heartbeat();
+            if (!ring.peer_alive(kPeerTimeoutNs)) {
+                std::cerr << "Producer: consumer died after " << i - 1 << " ticks" << std::endl;
+                return 1;
+            }
+            std::this_thread::yield();
+        }
+    }
+    std::cout << "Producer finished producing " << count << " ticks." << std::endl;
+    // Keep the segment (and our heartbeat) until the consumer has drained it
+    while (ring.size() > 0 && ring.peer_alive(kPeerTimeoutNs)) {
+        ring.heartbeat();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return 0;
+}
+
+// Consumer process: attaches to the segment and reads `count` ticks
+int run_consumer(const std::string& name, int count) {
+    TickRing ring = TickRing::attach(name, ShmSide::Consumer);
+    uint64_t total_latency = 0;
+    Tick t;
+    for (int received = 1; received <= count; ++received) {
+        while (!ring.try_pop(t)) {
+            ring.heartbeat();
+            if (!ring.peer_alive(kPeerTimeoutNs)) {
+                std::cerr << "Consumer: producer died after " << received - 1 << " ticks" << std::endl;
+                return 1;
+            }
+            std::this_thread::yield();
+        }
+        if (t.sequence != static_cast<uint64_t>(received))
+            std::cerr << "ERROR: Received tick " << t.sequence << " but expected " << received << std::endl;
+        total_latency += monotonic_ns() - t.timestamp;
+    }
+    std::cout << "Consumer finished consuming " << count << " ticks, mean latency "
+              << total_latency / count << " ns." << std::endl;
+    return 0;
+}
+
+// --- Forked demo ---
+
+// Runs `child` in a forked process; it must not touch the parent's handles
+template <typename Child>
+pid_t spawn(Child child) {
+    const pid_t pid = fork();
+    if (pid == 0) {
+        try {
+            _exit(child());
+        } catch (const std::system_error& e) {
+            std::cerr << "child: " << e.what() << std::endl;
+            _exit(1);
+        }
+    }
+    return pid;
+}
+
+int wait_child(pid_t pid) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// Function to stream ticks to a consumer process through the segment
+void stream_test(int count) {
+    const std::string name = "/pc_shm_stream";
+    TickRing ring = TickRing::create(name, 1024, ShmSide::Producer);
+    auto start = std::chrono::steady_clock::now();
+    const pid_t consumer = spawn([&]() {
+        TickRing r = TickRing::attach(name, ShmSide::Consumer);
+        int errors = 0;
+        for (int received = 1; received <= count; ++received)
+            errors += r.pop().sequence != static_cast<uint64_t>(received);
+        return errors ? 1 : 0;
+    });
+    for (int i = 1; i <= count; ++i)
+        ring.push(Tick{static_cast<uint64_t>(i), 0, 100.0, 100.5});
+    const int status = wait_child(consumer);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (status != 0)
+        std::cerr << "ERROR: consumer process saw ticks out of sequence" << std::endl;
+    std::cout << "Stream: " << count << " ticks to another process in " << elapsed.count() << " s ("
+              << count / elapsed.count() / 1e6 << " M ticks/s)" << std::endl;
+}
+
+// Mean and median of round trip times, in nanoseconds
+void report_round_trips(const char* name, std::vector<uint64_t>& rtt) {
+    uint64_t sum = 0;
+    for (uint64_t r : rtt)
+        sum += r;
+    std::sort(rtt.begin(), rtt.end());
+    std::cout << name << ": " << rtt.size() << " round trips, mean " << sum / rtt.size()
+              << " ns, median " << rtt[rtt.size() / 2] << " ns" << std::endl;
+}
+
+// Function to ping-pong one tick between two processes over a pair of rings
+void shm_round_trip_test(int rounds) {
+    TickRing ping = TickRing::create("/pc_shm_ping", 64, ShmSide::Producer);
+    TickRing pong = TickRing::create("/pc_shm_pong", 64, ShmSide::Consumer);
+    const pid_t echo = spawn([&]() {
+        TickRing in = TickRing::attach("/pc_shm_ping", ShmSide::Consumer);
+        TickRing out = TickRing::attach("/pc_shm_pong", ShmSide::Producer);
+        for (int i = 0; i < rounds; ++i)
+            out.push(in.pop());
+        return 0;
+    });
+    std::vector<uint64_t> rtt;
+    rtt.reserve(rounds);
+    for (int i = 0; i < rounds; ++i) {
+        const uint64_t start = monotonic_ns();
+        ping.push(Tick{static_cast<uint64_t>(i), start, 0.0, 0.0});
+        pong.pop();
+        rtt.push_back(monotonic_ns() - start);
+    }
+    wait_child(echo);
+    report_round_trips("Shared-memory rings", rtt);
+}
+
+// The same ping-pong over a Unix socket pair, the transport this replaces
+void socket_round_trip_test(int rounds) {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        std::perror("socketpair");
+        return;
+    }
+    const pid_t echo = spawn([&]() {
+        Tick t;
+        for (int i = 0; i < rounds; ++i) {
+            if (read(fds[1], &t, sizeof(t)) != sizeof(t) || write(fds[1], &t, sizeof(t)) != sizeof(t))
+                return 1;
+        }
+        return 0;
+    });
+    std::vector<uint64_t> rtt;
+    rtt.reserve(rounds);
+    Tick t{};
+    for (int i = 0; i < rounds; ++i) {
+        const uint64_t start = monotonic_ns();
+        if (write(fds[0], &t, sizeof(t)) != sizeof(t) || read(fds[0], &t, sizeof(t)) != sizeof(t))
+            break;
+        rtt.push_back(monotonic_ns() - start);
+    }
+    wait_child(echo);
+    close(fds[0]);
+    close(fds[1]);
+    report_round_trips("Unix socket pair", rtt);
+}
+
+// Function to show a killed consumer being detected, and its restart noticed
+void dead_peer_test() {
+    const std::string name = "/pc_shm_liveness";
+    TickRing ring = TickRing::create(name, 64, ShmSide::Producer);
+    auto start_consumer = [&]() {
+        return spawn([&]() {
+            TickRing r = TickRing::attach(name, ShmSide::Consumer);
+            while (true) {   // an idle consumer that keeps heartbeating
+                r.heartbeat();
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            return 0;
+        });
+    };
+    auto wait_for_generation = [&](uint32_t generation) {
+        while (ring.peer_generation() < generation)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    };
+
+    pid_t consumer = start_consumer();
+    wait_for_generation(1);
+    std::cout << "Liveness: consumer " << consumer << " attached, alive = " << ring.peer_alive(kPeerTimeoutNs) << std::endl;
+    kill(consumer, SIGKILL);
+    wait_child(consumer);
+    std::cout << "Liveness: consumer killed, alive = " << ring.peer_alive(kPeerTimeoutNs) << std::endl;
+
+    consumer = start_consumer();
+    wait_for_generation(2);
+    std::cout << "Liveness: consumer restarted as " << consumer << " (generation " << ring.peer_generation()
+              << "), alive = " << ring.peer_alive(kPeerTimeoutNs) << std::endl;
+    kill(consumer, SIGKILL);
+    wait_child(consumer);
+}
+
+// Usage: producer_consumer                        forked demo
+//        producer_consumer producer NAME COUNT    feed handler side
+//        producer_consumer consumer NAME COUNT    strategy side (start after the producer)
+int main(int argc, char* argv[]) {
+    if (argc == 4) {
+        const std::string mode = argv[1];
+        const int count = std::atoi(argv[3]);
+        try {
+            if (mode == "producer")
+                return run_producer(argv[2], count);
+            if (mode == "consumer")
+                return run_consumer(argv[2], count);
+        } catch (const std::system_error& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    if (argc != 1) {
+        std::cerr << "Usage: " << argv[0] << " [producer|consumer NAME COUNT]" << std::endl;
+        return 1;
+    }
+
+    const int ITEM_COUNT = 500000;
+    const int ROUNDS = 20000;
+    stream_test(ITEM_COUNT);
+    shm_round_trip_test(ROUNDS);
+    socket_round_trip_test(ROUNDS);
+    dead_peer_test();
+
+    std::cout << "\nShared-Memory SPSC Ring Test Complete." << std::endl;
+    return 0;
+}
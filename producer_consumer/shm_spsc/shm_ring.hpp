@@ -0,0 +1,322 @@
+#ifndef SHM_RING_HPP
+#define SHM_RING_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "cache_line.hpp"
+#include "wait_strategy.hpp"
+
+// Single-producer/single-consumer ring of T shared between two processes.
+//
+// The segment is a POSIX shared-memory object (shm_open) or, with huge_pages, a
+// file on hugetlbfs (/dev/hugepages). It holds a ShmRingHeader followed by the
+// slots, and contains no pointers, only offsets from its own start, so each
+// process can map it at any address. The header starts with a magic number, a
+// layout version and the element size and alignment, and attach() refuses a
+// segment that does not match what this build expects.
+//
+// The counters work as in LockFreeSPSCRingBuffer: free-running head and tail,
+// each on its own line in the segment; each handle keeps its cached copy of
+// the opposite counter in its own process.
+//
+// Liveness: each side has an endpoint line holding its pid, a heartbeat (last
+// CLOCK_MONOTONIC time it called heartbeat(), comparable across processes) and
+// a generation that goes up every time a process attaches as that side. A peer
+// is dead when its pid is gone or its heartbeat is older than the caller's
+// limit; a changed generation means it was restarted. The rings' futex parking
+// is process-private, so blocking push/pop spin and yield (SpinYieldWait).
+//
+// T must be trivially copyable: elements are memcpy'd through the segment and
+// outlive the process that wrote them.
+
+struct ShmEndpoint {
+    std::atomic<int32_t> pid{0};              // 0 while nobody is attached
+    std::atomic<uint32_t> generation{0};      // attaches so far
+    std::atomic<uint64_t> heartbeat_ns{0};    // CLOCK_MONOTONIC
+};
+
+struct ShmRingHeader {
+    static constexpr uint64_t kMagic = 0x53484d5350534352ull;  // "SHMSPSCR"
+    static constexpr uint32_t kVersion = 1;
+
+    // --- Written once by the creator, validated by attach ---
+    uint64_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t slot_size;
+    uint64_t slot_align;
+    uint64_t capacity;         // power of two
+    uint64_t slots_offset;     // from the start of the segment
+    uint64_t mapped_size;
+    std::atomic<uint32_t> ready;   // set last, once the above is valid
+
+    alignas(kFalseSharingRange) ShmEndpoint producer;
+    alignas(kFalseSharingRange) ShmEndpoint consumer;
+
+    alignas(kFalseSharingRange) std::atomic<uint64_t> head;   // producer's counter
+    alignas(kFalseSharingRange) std::atomic<uint64_t> tail;   // consumer's counter
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "shared-memory atomics must be lock-free to work across processes");
+static_assert(std::is_standard_layout<ShmRingHeader>::value, "header layout must be fixed");
+
+enum class ShmSide { Producer, Consumer };
+
+inline uint64_t monotonic_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+template <typename T>
+class ShmSPSCRing {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "elements are copied through shared memory");
+
+    struct Options {
+        bool huge_pages = false;   // back the segment with hugetlbfs 2 MB pages
+    };
+
+    // Creates a segment named `name` (e.g. "/feed") holding at least `capacity`
+    // elements and attaches to it as `side`. A stale segment of the same name
+    // is removed first; processes still mapping it keep the old one. The name
+    // is unlinked again when the creating handle is destroyed.
+    static ShmSPSCRing create(const std::string& name, size_t capacity, ShmSide side, Options options = Options()) {
+        const uint64_t slots = round_up_pow2(capacity);
+        const uint64_t slots_offset = (sizeof(ShmRingHeader) + kSlotAlign - 1) / kSlotAlign * kSlotAlign;
+        uint64_t size = slots_offset + slots * sizeof(T);
+        if (options.huge_pages)
+            size = (size + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+
+        remove(name, options);
+        const int fd = open_segment(name, options, O_CREAT | O_EXCL | O_RDWR);
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            const int err = errno;
+            close(fd);
+            remove(name, options);
+            throw std::system_error(err, std::generic_category(), "ftruncate " + name);
+        }
+        ShmSPSCRing ring(name, options, fd, size, side, true);
+
+        // The fresh segment is zero-filled, so the atomics start at 0
+        ShmRingHeader* h = ring.header_;
+        h->magic = ShmRingHeader::kMagic;
+        h->version = ShmRingHeader::kVersion;
+        h->header_size = sizeof(ShmRingHeader);
+        h->slot_size = sizeof(T);
+        h->slot_align = kSlotAlign;
+        h->capacity = slots;
+        h->slots_offset = slots_offset;
+        h->mapped_size = size;
+        h->ready.store(1, std::memory_order_release);
+        ring.claim_side();
+        return ring;
+    }
+
+    // Attaches to a segment made by create(), as `side`; throws if it does not
+    // exist yet, is still being initialised, or was built for a different layout
+    static ShmSPSCRing attach(const std::string& name, ShmSide side, Options options = Options()) {
+        const int fd = open_segment(name, options, O_RDWR);
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmRingHeader)) {
+            close(fd);
+            throw std::system_error(EINVAL, std::generic_category(), "attach " + name + ": segment too small");
+        }
+        ShmSPSCRing ring(name, options, fd, static_cast<uint64_t>(st.st_size), side, false);
+
+        const ShmRingHeader* h = ring.header_;
+        if (h->ready.load(std::memory_order_acquire) != 1)
+            throw std::system_error(EAGAIN, std::generic_category(), "attach " + name + ": not initialised yet");
+        if (h->magic != ShmRingHeader::kMagic || h->version != ShmRingHeader::kVersion ||
+            h->header_size != sizeof(ShmRingHeader) || h->slot_size != sizeof(T) || h->slot_align != kSlotAlign ||
+            h->mapped_size > ring.size_ || h->slots_offset + h->capacity * sizeof(T) > h->mapped_size)
+            throw std::system_error(EPROTO, std::generic_category(), "attach " + name + ": incompatible layout");
+        ring.claim_side();
+        return ring;
+    }
+
+    // Removes the segment's name; existing mappings stay valid
+    static void remove(const std::string& name, Options options = Options()) {
+        if (options.huge_pages)
+            unlink(huge_page_path(name).c_str());
+        else
+            shm_unlink(name.c_str());
+    }
+
+    ShmSPSCRing(ShmSPSCRing&& other) noexcept
+        : name_(std::move(other.name_)), options_(other.options_), base_(other.base_), size_(other.size_),
+          header_(other.header_), slots_(other.slots_), mask_(other.mask_), side_(other.side_),
+          owner_(other.owner_), cached_(other.cached_) {
+        other.base_ = nullptr;
+        other.owner_ = false;
+    }
+
+    ShmSPSCRing(const ShmSPSCRing&) = delete;
+    ShmSPSCRing& operator=(const ShmSPSCRing&) = delete;
+    ShmSPSCRing& operator=(ShmSPSCRing&&) = delete;
+
+    ~ShmSPSCRing() {
+        if (!base_)
+            return;
+        // Detach so the peer sees this side gone rather than waiting for the
+        // heartbeat to age (unless another process has taken the side over)
+        if (slots_) {
+            int32_t pid = static_cast<int32_t>(getpid());
+            self().pid.compare_exchange_strong(pid, 0, std::memory_order_acq_rel);
+        }
+        munmap(base_, size_);
+        if (owner_)
+            remove(name_, options_);
+    }
+
+    // Producer method: Attempts to copy `item` into the ring
+    // Returns true on success, false if the ring is full
+    bool try_push(const T& item) {
+        // 1. Load our own counter (only this process writes it)
+        const uint64_t head = header_->head.load(std::memory_order_relaxed);
+
+        // 2. Check for FULL against the cached tail, refreshing it only then
+        if (head - cached_ == capacity()) {
+            cached_ = header_->tail.load(std::memory_order_acquire);
+            if (head - cached_ == capacity())
+                return false;
+        }
+
+        // 3. Write the item, then publish it to the consumer
+        std::memcpy(&slots_[head & mask_], &item, sizeof(T));
+        header_->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer method: Attempts to copy the oldest item into `item`
+    // Returns true on success, false if the ring is empty
+    bool try_pop(T& item) { return pop_bytes(&item); }
+
+    // Blocking variants: spin, then yield, until the operation succeeds
+    void push(const T& item) {
+        SpinYieldWait().wait_until([&]() { return try_push(item); });
+    }
+
+    // Pops into raw storage, so T needs no default constructor
+    T pop() {
+        alignas(T) unsigned char storage[sizeof(T)];
+        SpinYieldWait().wait_until([&]() { return pop_bytes(storage); });
+        return *std::launder(reinterpret_cast<T*>(storage));
+    }
+
+    // --- Liveness ---
+
+    // Records that this side is alive; call it from the idle path, well within
+    // the peer's timeout
+    void heartbeat() { self().heartbeat_ns.store(monotonic_ns(), std::memory_order_release); }
+
+    // True when a process is attached as the other side, still exists and has
+    // heartbeated within `max_silence_ns`
+    bool peer_alive(uint64_t max_silence_ns) const {
+        const ShmEndpoint& p = peer();
+        const int32_t pid = p.pid.load(std::memory_order_acquire);
+        if (pid == 0 || (kill(pid, 0) != 0 && errno == ESRCH))
+            return false;
+        const uint64_t beat = p.heartbeat_ns.load(std::memory_order_acquire);
+        return monotonic_ns() - beat <= max_silence_ns;
+    }
+
+    // How many times a process has attached as the other side; a change means
+    // the peer restarted (its counter position is kept in the segment)
+    uint32_t peer_generation() const { return peer().generation.load(std::memory_order_acquire); }
+    bool peer_attached() const { return peer().pid.load(std::memory_order_acquire) != 0; }
+
+    size_t capacity() const { return mask_ + 1; }
+    size_t size() const {
+        return header_->head.load(std::memory_order_acquire) - header_->tail.load(std::memory_order_acquire);
+    }
+
+private:
+    // try_pop into untyped storage of sizeof(T) bytes
+    bool pop_bytes(void* out) {
+        // 1. Load our own counter (only this process writes it)
+        const uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+
+        // 2. Check for EMPTY against the cached head, refreshing it only then
+        if (tail == cached_) {
+            cached_ = header_->head.load(std::memory_order_acquire);
+            if (tail == cached_)
+                return false;
+        }
+
+        // 3. Read the item, then hand the slot back to the producer
+        std::memcpy(out, &slots_[tail & mask_], sizeof(T));
+        header_->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    static constexpr uint64_t kSlotAlign = alignof(T) > kCacheLineSize ? alignof(T) : kCacheLineSize;
+    static constexpr uint64_t kHugePageSize = 2 * 1024 * 1024;
+
+    ShmSPSCRing(const std::string& name, Options options, int fd, uint64_t size, ShmSide side, bool owner)
+        : name_(name), options_(options), size_(size), side_(side), owner_(owner) {
+        base_ = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+        const int err = errno;
+        close(fd);   // the mapping keeps the segment alive
+        if (base_ == MAP_FAILED) {
+            base_ = nullptr;
+            if (owner)
+                remove(name, options);
+            throw std::system_error(err, std::generic_category(), "mmap " + name);
+        }
+        header_ = static_cast<ShmRingHeader*>(base_);
+    }
+
+    static std::string huge_page_path(const std::string& name) {
+        return "/dev/hugepages/" + (name[0] == '/' ? name.substr(1) : name);
+    }
+
+    static int open_segment(const std::string& name, Options options, int flags) {
+        const int fd = options.huge_pages ? open(huge_page_path(name).c_str(), flags, 0600)
+                                          : shm_open(name.c_str(), flags, 0600);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), (options.huge_pages ? "open " : "shm_open ") + name);
+        return fd;
+    }
+
+    // Called once the header is valid: finds the slots and registers this process
+    void claim_side() {
+        slots_ = reinterpret_cast<T*>(static_cast<char*>(base_) + header_->slots_offset);
+        mask_ = header_->capacity - 1;
+        cached_ = side_ == ShmSide::Producer ? header_->tail.load(std::memory_order_acquire)
+                                             : header_->head.load(std::memory_order_acquire);
+        heartbeat();
+        self().generation.fetch_add(1, std::memory_order_acq_rel);
+        self().pid.store(static_cast<int32_t>(getpid()), std::memory_order_release);
+    }
+
+    ShmEndpoint& self() const { return side_ == ShmSide::Producer ? header_->producer : header_->consumer; }
+    ShmEndpoint& peer() const { return side_ == ShmSide::Producer ? header_->consumer : header_->producer; }
+
+    std::string name_;
+    Options options_;
+    void* base_ = nullptr;
+    uint64_t size_ = 0;
+    ShmRingHeader* header_ = nullptr;
+    T* slots_ = nullptr;      // set once attached
+    uint64_t mask_ = 0;
+    ShmSide side_;
+    bool owner_;
+    uint64_t cached_ = 0;   // producer: last seen tail; consumer: last seen head
+};
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef CHASE_LEV_DEQUE_HPP
+#define CHASE_LEV_DEQUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "cache_line.hpp"
+
+// Chase-Lev work-stealing deque (Chase & Lev 2005, with the C11 orderings of
+// Le, Pop, Cohen & Zappa Nardelli 2013).
+//
+// The owning worker pushes and pops at the bottom, LIFO, with no atomic
+// read-modify-write except when it races a thief for the last element. Thieves
+// take from the top, FIFO, with one CAS on top_. The buffer is a power-of-two
+// circular array that the owner doubles when it fills; thieves may still be
+// reading the old one, so retired buffers are kept until the deque is destroyed
+// (they total less than the final buffer).
+//
+// T must be trivially copyable (the pool stores Task pointers): a thief reads
+// the slot before its CAS, and may read a value it then fails to claim.
+template <typename T>
+class ChaseLevDeque {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "slots are read racily by thieves");
+
+    explicit ChaseLevDeque(size_t capacity = 256)
+        : buffer_(new Buffer(round_up_pow2(capacity))) {}
+
+    ~ChaseLevDeque() { delete buffer_.load(std::memory_order_relaxed); }
+
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    // Owner method: Pushes an item at the bottom, growing the buffer when full
+    void push(T item) {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        if (bottom - top > buffer->mask)
+            buffer = grow(buffer, top, bottom);
+        buffer->put(bottom, item);
+        bottom_.store(bottom + 1, std::memory_order_release);   // publishes the slot to thieves
+    }
+
+    // Owner method: Pops the most recently pushed item
+    // Returns false if the deque is empty (or a thief took the last item)
+    bool pop(T& item) {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            // Empty: undo the reservation
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        item = buffer->get(bottom);
+        if (top == bottom) {
+            // Last item: race the thieves for it through top_
+            const bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Thief method: Takes the oldest item
+    // Returns false if the deque is empty or another thread got there first
+    bool steal(T& item) {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom)
+            return false;
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        item = buffer->get(top);
+        return top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    // Approximate: exact only when no other thread is operating on the deque
+    bool empty() const {
+        return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(size_t capacity) : mask(static_cast<int64_t>(capacity) - 1), slots(new std::atomic<T>[capacity]) {}
+
+        T get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T item) { slots[i & mask].store(item, std::memory_order_relaxed); }
+
+        const int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    Buffer* grow(Buffer* old, int64_t top, int64_t bottom) {
+        Buffer* bigger = new Buffer(2 * (old->mask + 1));
+        for (int64_t i = top; i < bottom; ++i)
+            bigger->put(i, old->get(i));
+        retired_.emplace_back(old);
+        buffer_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    // Thieves write top_; only the owner writes bottom_ and buffer_
+    alignas(kFalseSharingRange) std::atomic<int64_t> top_{0};
+    alignas(kFalseSharingRange) std::atomic<int64_t> bottom_{0};
+    std::atomic<Buffer*> buffer_;
+    std::vector<std::unique_ptr<Buffer>> retired_;   // owner-only
+};
+
+#endif
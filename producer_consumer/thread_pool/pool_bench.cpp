@@ -0,0 +1,175 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <omp.h>
+#include "thread_pool.hpp"
+
+// ThreadPool against OpenMP on the repo's own kernels:
+//
+//   sum_of_squares  op_demo/parallel/sumSquaresParallel.cpp (reduction)
+//   matmul          op_demo/matrix_2/matrix_multiplication.c (i-k-j, rows x
+//                   column blocks, collapse(2) schedule(static))
+//   fib             naive recursive fork-join, one task per call above a cutoff:
+//                   measures spawn/join overhead against OpenMP tasks
+//
+// Each kernel runs with 1..max_threads threads, best of `reps`, and the results
+// are checked against each other.
+
+const int COL_BLOCK = 256;
+
+template <typename Fn>
+double best_of(int reps, Fn fn) {
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+// --- Sum of squares ---
+
+unsigned long long sum_of_squares_omp(unsigned long long N) {
+    unsigned long long sum = 0;
+    #pragma omp parallel for reduction(+:sum)
+    for (unsigned long long i = 1; i <= N; ++i) {
+        sum += i * i;
+    }
+    return sum;
+}
+
+unsigned long long sum_of_squares_pool(ThreadPool& pool, unsigned long long N) {
+    return pool.parallel_reduce(1, N + 1, 1 << 20, 0ull,
+        [](size_t begin, size_t end) {
+            unsigned long long sum = 0;
+            for (unsigned long long i = begin; i < end; ++i)
+                sum += i * i;
+            return sum;
+        },
+        [](unsigned long long a, unsigned long long b) { return a + b; });
+}
+
+// --- Matrix multiply ---
+
+// One (row, column block) piece of C = A * B
+void multiply_block(const int* A, const int* B, int* C, int n, int i, int jb) {
+    const int j_end = jb + COL_BLOCK < n ? jb + COL_BLOCK : n;
+    int* c_row = C + static_cast<size_t>(i) * n;
+    for (int j = jb; j < j_end; j++)
+        c_row[j] = 0;
+    for (int k = 0; k < n; k++) {
+        const int a_ik = A[static_cast<size_t>(i) * n + k];
+        const int* b_row = B + static_cast<size_t>(k) * n;
+        #pragma omp simd
+        for (int j = jb; j < j_end; j++)
+            c_row[j] += a_ik * b_row[j];
+    }
+}
+
+void matmul_omp(const int* A, const int* B, int* C, int n) {
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int i = 0; i < n; i++)
+        for (int jb = 0; jb < n; jb += COL_BLOCK)
+            multiply_block(A, B, C, n, i, jb);
+}
+
+void matmul_pool(ThreadPool& pool, const int* A, const int* B, int* C, int n) {
+    const int blocks = (n + COL_BLOCK - 1) / COL_BLOCK;
+    pool.parallel_for(0, static_cast<size_t>(n) * blocks, 1, [&](size_t begin, size_t end) {
+        for (size_t piece = begin; piece < end; ++piece)
+            multiply_block(A, B, C, n, static_cast<int>(piece / blocks), static_cast<int>(piece % blocks) * COL_BLOCK);
+    });
+}
+
+long long checksum(const std::vector<int>& C) {
+    long long sum = 0;
+    for (int c : C)
+        sum += c;
+    return sum;
+}
+
+// --- Fork-join ---
+
+const int FIB_CUTOFF = 12;
+
+long fib_serial(int n) { return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2); }
+
+long fib_omp_task(int n) {
+    if (n < FIB_CUTOFF)
+        return fib_serial(n);
+    long a, b;
+    #pragma omp task shared(a)
+    a = fib_omp_task(n - 1);
+    b = fib_omp_task(n - 2);
+    #pragma omp taskwait
+    return a + b;
+}
+
+long fib_omp(int n) {
+    long result = 0;
+    #pragma omp parallel
+    #pragma omp single
+    result = fib_omp_task(n);
+    return result;
+}
+
+long fib_pool(ThreadPool& pool, int n) {
+    if (n < FIB_CUTOFF)
+        return fib_serial(n);
+    long a = 0;
+    ThreadPool::TaskGroup group(pool);
+    group.run([&]() { a = fib_pool(pool, n - 1); });
+    const long b = fib_pool(pool, n - 2);
+    group.wait();
+    return a + b;
+}
+
+void report(const char* kernel, int threads, double omp_time, double pool_time, bool match) {
+    std::cout << std::left << std::setw(16) << kernel << std::right << " threads=" << std::setw(2) << threads
+              << "  omp " << std::fixed << std::setprecision(4) << omp_time << " s"
+              << "  pool " << pool_time << " s"
+              << "  pool/omp " << std::setprecision(2) << pool_time / omp_time
+              << (match ? "" : "  RESULTS DIFFER") << std::endl;
+}
+
+// Usage: pool_bench [max_threads] [reps] [N] [matrix_n] [fib_n]
+int main(int argc, char* argv[]) {
+    const int max_threads = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(std::thread::hardware_concurrency());
+    const int reps = argc > 2 ? std::atoi(argv[2]) : 3;
+    const unsigned long long N = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 200000000ull;
+    const int n = argc > 4 ? std::atoi(argv[4]) : 512;
+    const int fib_n = argc > 5 ? std::atoi(argv[5]) : 32;
+
+    std::vector<int> A(static_cast<size_t>(n) * n), B(A.size()), C_omp(A.size()), C_pool(A.size());
+    for (size_t i = 0; i < A.size(); ++i) {
+        A[i] = static_cast<int>(i * 7 % 10);
+        B[i] = static_cast<int>(i * 13 % 10);
+    }
+
+    std::cout << "sum_of_squares N=" << N << ", matmul " << n << "x" << n << ", fib(" << fib_n
+              << ") cutoff " << FIB_CUTOFF << ", best of " << reps << std::endl;
+    for (int threads = 1; threads <= max_threads; ++threads) {
+        omp_set_num_threads(threads);
+        ThreadPool pool(threads);
+
+        unsigned long long s_omp = 0, s_pool = 0;
+        const double t_omp = best_of(reps, [&]() { s_omp = sum_of_squares_omp(N); });
+        const double t_pool = best_of(reps, [&]() { s_pool = sum_of_squares_pool(pool, N); });
+        report("sum_of_squares", threads, t_omp, t_pool, s_omp == s_pool);
+
+        const double m_omp = best_of(reps, [&]() { matmul_omp(A.data(), B.data(), C_omp.data(), n); });
+        const double m_pool = best_of(reps, [&]() { matmul_pool(pool, A.data(), B.data(), C_pool.data(), n); });
+        report("matmul", threads, m_omp, m_pool, checksum(C_omp) == checksum(C_pool));
+
+        long f_omp = 0, f_pool = 0;
+        const double f_omp_time = best_of(reps, [&]() { f_omp = fib_omp(fib_n); });
+        const double f_pool_time = best_of(reps, [&]() { f_pool = fib_pool(pool, fib_n); });
+        report("fib", threads, f_omp_time, f_pool_time, f_omp == f_pool);
+    }
+    return 0;
+}
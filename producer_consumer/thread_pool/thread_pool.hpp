@@ -0,0 +1,232 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "cache_line.hpp"
+#include "wait_strategy.hpp"
+#include "mpmc_queue.hpp"
+#include "chase_lev_deque.hpp"
+
+// Work-stealing thread pool.
+//
+// Every worker owns a ChaseLevDeque of tasks: it pushes the tasks it spawns and
+// pops them back LIFO (hot in cache, depth-first), while idle workers steal the
+// oldest (biggest) ones from the other end. Threads outside the pool submit
+// through a global injection queue (MPMCQueue); if that is full, the task runs
+// inline. Idle workers look for work through ParkingWait: they spin and yield
+// for a while, then sleep on the eventcount, and every spawn notifies, which
+// costs a fence and a load while nobody is asleep.
+//
+// Fork-join: a TaskGroup counts its outstanding tasks; wait() runs other tasks
+// (its own first, if they are still in the local deque) until the count drops to
+// zero, so a waiting thread never idles while there is work. parallel_for and
+// parallel_reduce split a range in halves down to a grain size, spawning one half
+// and recursing into the other.
+//
+// A pool of `threads` starts threads - 1 workers; the thread that calls wait()
+// is the last participant, as the master thread is in an OpenMP team.
+class ThreadPool {
+    struct Task;
+
+public:
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+        ~TaskGroup() { wait(); }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        // Spawns fn() as a task of this group
+        template <typename Fn>
+        void run(Fn&& fn) {
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            pool_.submit(new FnTask<typename std::decay<Fn>::type>(this, std::forward<Fn>(fn)));
+        }
+
+        // Returns once every task spawned in this group (and by them) has run
+        void wait() {
+            SpinYieldWait().wait_until([this]() {
+                if (pending_.load(std::memory_order_acquire) == 0)
+                    return true;
+                if (Task* task = pool_.find_task())
+                    pool_.execute(task);
+                return pending_.load(std::memory_order_acquire) == 0;
+            });
+        }
+
+    private:
+        friend class ThreadPool;
+        ThreadPool& pool_;
+        std::atomic<size_t> pending_{0};
+    };
+
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency()) {
+        const unsigned workers = threads > 1 ? threads - 1 : 0;
+        for (unsigned w = 0; w < workers; ++w)
+            workers_.emplace_back(new Worker(w));
+        for (unsigned w = 0; w < workers; ++w)
+            threads_.emplace_back(&ThreadPool::worker_loop, this, w);
+    }
+
+    ~ThreadPool() {
+        stopping_.store(true, std::memory_order_release);
+        idle_.notify_all();
+        for (std::thread& t : threads_)
+            t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads that run tasks: the workers plus the caller
+    unsigned size() const { return static_cast<unsigned>(workers_.size()) + 1; }
+
+    // Runs body(b, e) over subranges of [begin, end) no longer than `grain`
+    template <typename Body>
+    void parallel_for(size_t begin, size_t end, size_t grain, const Body& body) {
+        if (begin >= end)
+            return;
+        TaskGroup group(*this);
+        split(group, begin, end, std::max<size_t>(grain, 1), body);
+        group.wait();
+    }
+
+    // combine() of map(b, e) over subranges of [begin, end) no longer than `grain`
+    template <typename T, typename Map, typename Combine>
+    T parallel_reduce(size_t begin, size_t end, size_t grain, T identity, const Map& map, const Combine& combine) {
+        if (begin >= end)
+            return identity;
+        if (end - begin <= std::max<size_t>(grain, 1))
+            return map(begin, end);
+        const size_t mid = begin + (end - begin) / 2;
+        T right = identity;
+        TaskGroup group(*this);
+        group.run([&]() { right = parallel_reduce(mid, end, grain, identity, map, combine); });
+        T left = parallel_reduce(begin, mid, grain, identity, map, combine);
+        group.wait();
+        return combine(left, right);
+    }
+
+private:
+    struct Task {
+        explicit Task(TaskGroup* g, void (*fn)(Task*)) : group(g), invoke(fn) {}
+        TaskGroup* group;
+        void (*invoke)(Task*);   // runs and deletes the task
+    };
+
+    template <typename Fn>
+    struct FnTask : Task {
+        template <typename F>
+        FnTask(TaskGroup* g, F&& f) : Task(g, &FnTask::run), fn(std::forward<F>(f)) {}
+        static void run(Task* task) {
+            FnTask* self = static_cast<FnTask*>(task);
+            self->fn();
+            delete self;
+        }
+        Fn fn;
+    };
+
+    struct alignas(kFalseSharingRange) Worker {
+        explicit Worker(unsigned index) : rng(0x9e3779b97f4a7c15ull * (index + 1)) {}
+        ChaseLevDeque<Task*> deque;
+        uint64_t rng;   // victim selection (xorshift)
+    };
+
+    // Which pool and worker the current thread is, if any
+    struct Context {
+        ThreadPool* pool = nullptr;
+        Worker* worker = nullptr;
+    };
+    static Context& context() {
+        static thread_local Context ctx;
+        return ctx;
+    }
+
+    Worker* current_worker() const {
+        const Context& ctx = context();
+        return ctx.pool == this ? ctx.worker : nullptr;
+    }
+
+    void submit(Task* task) {
+        if (Worker* self = current_worker())
+            self->deque.push(task);
+        else if (!injected_.try_push(task)) {
+            execute(task);   // injection queue full: run it here
+            return;
+        }
+        idle_.notify();
+    }
+
+    void execute(Task* task) {
+        TaskGroup* group = task->group;
+        task->invoke(task);
+        // Last touch of the group: its owner may return from wait() right after
+        group->pending_.fetch_sub(1, std::memory_order_release);
+    }
+
+    // Own deque first, then the injection queue, then the other workers
+    Task* find_task() {
+        Task* task = nullptr;
+        Worker* self = current_worker();
+        if (self && self->deque.pop(task))
+            return task;
+        if (injected_.try_pop(task))
+            return task;
+        const size_t workers = workers_.size();
+        if (workers == 0)
+            return nullptr;
+        uint64_t r = self ? self->rng : reinterpret_cast<uintptr_t>(&task);
+        r ^= r << 13;
+        r ^= r >> 7;
+        r ^= r << 17;
+        if (self)
+            self->rng = r;
+        for (size_t i = 0; i < workers; ++i) {
+            Worker* victim = workers_[(r + i) % workers].get();
+            if (victim != self && victim->deque.steal(task))
+                return task;
+        }
+        return nullptr;
+    }
+
+    void worker_loop(unsigned index) {
+        context() = Context{this, workers_[index].get()};
+        while (true) {
+            Task* task = nullptr;
+            idle_.wait_until([&]() {
+                task = find_task();
+                return task != nullptr || stopping_.load(std::memory_order_acquire);
+            });
+            if (!task)
+                return;
+            execute(task);
+        }
+    }
+
+    template <typename Body>
+    void split(TaskGroup& group, size_t begin, size_t end, size_t grain, const Body& body) {
+        // Hand off the upper halves and keep splitting the lower one
+        while (end - begin > grain) {
+            const size_t mid = begin + (end - begin) / 2;
+            group.run([this, &group, mid, end, grain, &body]() { split(group, mid, end, grain, body); });
+            end = mid;
+        }
+        body(begin, end);
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    MPMCQueue<Task*, 4096, BusySpinWait> injected_;
+    alignas(kFalseSharingRange) ParkingWait idle_;
+    alignas(kFalseSharingRange) std::atomic<bool> stopping_{false};
+};
+
+#endif